@@ -138,6 +138,27 @@ void CRCInit(void)
   }
 }
 
+/**
+ * Checks a MISO frame (1 byte Status/ 2 bytes Data/ 1 byte CRC) with the fast CRC LUT
+ * The CRC covers status and data, same seed as the MOSI frames
+ * `uint32_t frame` - Full 32-bit MISO frame<br>
+ * Returns `bool` - `true` if the CRC matches, otherwise `false` and `crcErrorCount` is incremented
+ */
+uint32_t crcErrorCount = 0; // MISO frames failing the CRC check
+
+bool CheckResponse(uint32_t frame)
+{
+  uint8_t data_temp[3] = { (uint8_t)(frame >> 24), (uint8_t)(frame >> 16), (uint8_t)(frame >> 8) };
+
+  if (CalcCRC(data_temp, 3, SPI_SEED) == (uint8_t)frame)
+  {
+    return true;
+  }
+
+  crcErrorCount++;
+  return false;
+}
+
 /**
  *  SPI Initialization
  *  MCU Dependent
@@ -355,8 +376,14 @@ void loop()
   Serial.print("CRC: 0x");
   Serial.println(responseCRC, HEX);
 
+  // Check frame - a corrupted angle is never decoded
+  if(!CheckResponse(responseFrame))
+  {
+    Serial.print("CRC ERROR - frame dropped, errors: ");
+    Serial.println(crcErrorCount);
+  }
   // Option to decode angle
-  if(DECODE_ANGLE)
+  else if(DECODE_ANGLE)
   {
     Serial.print("###########ANGLE[deg]: ");
     Serial.println(GetAngleDeg(responseData), 2);
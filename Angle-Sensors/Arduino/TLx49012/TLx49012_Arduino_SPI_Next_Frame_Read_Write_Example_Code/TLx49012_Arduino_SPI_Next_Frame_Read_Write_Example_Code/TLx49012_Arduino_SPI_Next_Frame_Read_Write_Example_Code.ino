@@ -93,6 +93,8 @@
 // USER CONFIGURATION AREA
 #define USR_CONFIG_START_ADDRESS  63 
 #define USR_CONFIG_STOP_ADDRESS   77
+#define USR_CONFIG_COUNT          (USR_CONFIG_STOP_ADDRESS - USR_CONFIG_START_ADDRESS + 1)
+#define USR_CONFIG_ALL            ((uint16_t)((1UL << USR_CONFIG_COUNT) - 1))
 
 // SPI NEXT FRAME COMMANDS
 #define CMD_ADDR		  0xFF
@@ -129,6 +131,27 @@ void CRCInit(void)
   }
 }
 
+/**
+ * Checks a MISO frame (1 byte Status/ 2 bytes Data/ 1 byte CRC) with the fast CRC LUT
+ * The CRC covers status and data, same seed as the MOSI frames
+ * `uint32_t frame` - Full 32-bit MISO frame<br>
+ * Returns `bool` - `true` if the CRC matches, otherwise `false` and `crcErrorCount` is incremented
+ */
+uint32_t crcErrorCount = 0; // MISO frames failing the CRC check
+
+bool CheckResponse(uint32_t frame)
+{
+  uint8_t data_temp[3] = { (uint8_t)(frame >> 24), (uint8_t)(frame >> 16), (uint8_t)(frame >> 8) };
+
+  if (CalcCRC(data_temp, 3, SPI_SEED) == (uint8_t)frame)
+  {
+    return true;
+  }
+
+  crcErrorCount++;
+  return false;
+}
+
 /**
  *  SPI Initialization
  *  MCU Dependent
@@ -265,57 +288,259 @@ uint32_t SpiWriteRegNextFrame(uint16_t addr, uint16_t data)
 	return SpiWriteNextFrame(data);
 }
 
- /**
- * Function for calculating the User Configuration block CRC
- * Reads all user bitmap registers with auto increment
- * Input: (8bit) start address of block, (8bit) stop address of block, (bool) option to clear device status
- * Output: (8bit) calculated block CRC
+/**
+ *  Next Frame Architecture
+ *  MCU Independent
+ *  SPI Read Register List Next Frame
+ *  The command for register N+1 is sent in the frame that returns register N. Contiguous addresses use the
+ *  AC_READ_INC auto increment instead of a new command => count + 1 frames instead of 2 * count
+ *  Every response is checked with CheckResponse(), registers whose response fails keep their old data
+ *  Input: (14 bit max) register addresses in any order, number of registers, (bool) option to clear device status
+ *         (last frame only), buffer for the register data
+ *  Output: (8 bit) number of frames sent, 0 if a response failed the CRC check - register data stored in address
+ *          list order
+ */
+uint8_t SpiReadRegListNextFrame(const uint16_t *addrList, uint8_t count, bool clearStatus, uint16_t *data)
+{
+  uint32_t resp;
+  bool valid = true;
+
+  if (count == 0)
+  {
+    return 0; // Empty list
+  }
+
+  SpiCommandNextFrame(addrList[0], AC_READ_INC); // Address first register, do not care about response
+
+  for (uint8_t i = 1; i <= count; i++)
+  {
+    if ((i < count) && (addrList[i] != (uint16_t)(addrList[i - 1] + 1)))
+    {
+      resp = SpiCommandNextFrame(addrList[i], AC_READ_INC);   // Address next register, receive previous one
+    }
+    else
+    {
+      resp = SpiReadNextFrame(clearStatus && (i == count));   // Auto increment to next register / last register
+    }
+
+    if (!CheckResponse(resp))
+    {
+      valid = false; // Corrupted frame - keep the old data, fail the list
+      continue;
+    }
+
+    data[i - 1] = (uint16_t)((resp >> 8) & 0xFFFF); // Take data
+  }
+
+  return valid ? (count + 1) : 0;
+}
+
+/**
+ *  User Configuration Shadow
+ *  MCU Independent
+ *  Copy of the user configuration area holding the last value written or read. Unchanged registers and CRC line
+ *  are not written again, read backs are batched in one register list.
+ *  Stays valid as long as the sensor keeps its registers - invalidate after a restart from NVM
+ */
+uint16_t usrConfigShadow[USR_CONFIG_COUNT];   // Last value written or read
+uint16_t usrConfigKnown      = 0;             // Bit i: usrConfigShadow[i] is valid
+uint16_t usrConfigUnverified = 0;             // Bit i: written, not read back yet
+
+/**
+ *  User Configuration Block CRC
+ *  MCU Independent
+ *  Block CRC of the shadow, kept up to date incrementally: usrConfigCrcState[i] is the CRC register before word i,
+ *  so a change of word i only reprocesses the words from i onward - the CRC line itself costs one byte
+ */
+uint8_t usrConfigCrcState[USR_CONFIG_COUNT + 1] = { CONFIG_SEED }; // [0]: seed, [USR_CONFIG_COUNT]: after the last word
+uint8_t usrConfigCrcFrom = 0;                                       // First word not hashed yet, USR_CONFIG_COUNT if none
+
+/**
+ *  Shadow Changed
+ *  Marks word i of the shadow as changed, the next CRC starts from there at the latest
+ */
+void ShadowChanged(uint8_t i)
+{
+  if (i < usrConfigCrcFrom)
+  {
+    usrConfigCrcFrom = i;
+  }
+}
+
+/**
+ *  Shadow Invalidate
+ *  Forgets the shadow, e.g. after a restart from NVM. The next write of each register goes to the sensor
+ */
+void ShadowInvalidate(void)
+{
+  usrConfigKnown      = 0;
+  usrConfigUnverified = 0;
+}
+
+/**
+ *  Shadow Refresh
+ *  Reads the whole user configuration area into the shadow - one register list, count + 1 frames
+ *  A response failing the CRC check rejects the whole refresh, the shadow is left as it was
+ *  Output: (8 bit) number of frames sent, 0 if rejected
+ */
+uint8_t ShadowRefresh(void)
+{
+  uint16_t addrList[USR_CONFIG_COUNT];
+  uint16_t data[USR_CONFIG_COUNT];
+
+  for (uint8_t i = 0; i < USR_CONFIG_COUNT; i++)
+  {
+    addrList[i] = USR_CONFIG_START_ADDRESS + i;
+  }
+
+  uint8_t frames = SpiReadRegListNextFrame(addrList, USR_CONFIG_COUNT, true, data);
+
+  if (frames == 0)
+  {
+    return 0; // Corrupted response - shadow unchanged
+  }
+
+  for (uint8_t i = 0; i < USR_CONFIG_COUNT; i++)
+  {
+    usrConfigShadow[i] = data[i];
+  }
+
+  usrConfigKnown      = USR_CONFIG_ALL;
+  usrConfigUnverified = 0;
+  ShadowChanged(0);
+
+  return frames;
+}
+
+/**
+ *  Shadow Differs
+ *  Input: ((14 bit max) address of target register, (16 bit) data to compare with)
+ *  Output: (bool) true if the register is unknown, holds other data or is not in the user configuration area
  */
-uint32_t CalcUserConfigCRC(uint8_t startAddr, uint8_t stopAddr, bool clearStatus)
+bool ShadowDiffers(uint16_t addr, uint16_t data)
 {
-  if (stopAddr < startAddr)
+  if ((addr < USR_CONFIG_START_ADDRESS) || (addr > USR_CONFIG_STOP_ADDRESS))
   {
-    return 0; // Empty range
+    return true; // Not shadowed
   }
 
-  uint8_t count = (uint8_t)(stopAddr - startAddr + 1);
+  uint8_t i = (uint8_t)(addr - USR_CONFIG_START_ADDRESS);
 
-  uint8_t stream[2 * count - 1]; // Last register contains also the CRC of the block => use only MSB from register 
-  uint8_t idx = 0;
+  return !(usrConfigKnown & (1U << i)) || (usrConfigShadow[i] != data);
+}
 
-  SpiCommandNextFrame(startAddr, AC_READ_INC); // Send next frame read command with auto increment to the first register address, do not care about response
+/**
+ *  Shadow Write Register Next Frame
+ *  Writes the register only if the shadow differs, the write is left for ShadowVerify()
+ *  Input: ((14 bits max) address of target register, (16 bits) data to be written to the addressed register)
+ *  Output: (bool) true if written, false if unchanged (no SPI traffic)
+ */
+bool ShadowWriteRegNextFrame(uint16_t addr, uint16_t data)
+{
+  if (!ShadowDiffers(addr, data))
+  {
+    return false; // Unchanged
+  }
 
-  for (uint8_t i = 0; i < count; i++)
+  SpiWriteRegNextFrame(addr, data);
+
+  if ((addr >= USR_CONFIG_START_ADDRESS) && (addr <= USR_CONFIG_STOP_ADDRESS))
   {
-    uint32_t resp = SpiReadNextFrame(clearStatus); // Read registers with auto increment
+    uint8_t i = (uint8_t)(addr - USR_CONFIG_START_ADDRESS);
+
+    usrConfigShadow[i]   = data;
+    usrConfigKnown      |= (1U << i);
+    usrConfigUnverified |= (1U << i);
+    ShadowChanged(i);
+  }
 
-    uint8_t msb = (uint8_t)((resp >> 16) & 0xFF); // Take data MSB
-    uint8_t lsb = (uint8_t)((resp >>  8) & 0xFF); // Take data LSB
+  return true;
+}
 
-    if (i == (uint8_t)(count - 1))
+/**
+ *  Shadow Verify
+ *  Reads back all registers written since the last verification as one register list
+ *  Input: (bool) option to clear device status (last frame only)
+ *  Output: (bool) true if all registers hold the written data - mismatching registers take the value read.
+ *          false without any change if a response failed the CRC check, the registers stay unverified
+ */
+bool ShadowVerify(bool clearStatus)
+{
+  uint16_t addrList[USR_CONFIG_COUNT];
+  uint16_t data[USR_CONFIG_COUNT];
+  uint8_t count = 0;
+  bool verified = true;
+
+  for (uint8_t i = 0; i < USR_CONFIG_COUNT; i++)
+  {
+    if (usrConfigUnverified & (1U << i))
     {
-      stream[idx++] = msb; // Last word: only MSB
+      addrList[count++] = USR_CONFIG_START_ADDRESS + i;
     }
-    else
+  }
+
+  if ((count != 0) && (SpiReadRegListNextFrame(addrList, count, clearStatus, data) == 0))
+  {
+    return false; // Corrupted response - retry later
+  }
+
+  for (uint8_t j = 0; j < count; j++)
+  {
+    uint8_t i = (uint8_t)(addrList[j] - USR_CONFIG_START_ADDRESS);
+
+    if (data[j] != usrConfigShadow[i])
+    {
+      usrConfigShadow[i] = data[j];
+      ShadowChanged(i);
+      verified = false;
+    }
+  }
+
+  usrConfigUnverified = 0;
+
+  return verified;
+}
+
+ /**
+ * Function for calculating the User Configuration block CRC from the shadow - no SPI traffic
+ * Hashes only the words changed since the last call, from the first changed word onward
+ * Output: (8bit) calculated block CRC
+ */
+uint8_t CalcShadowConfigCRC(void)
+{
+  for (uint8_t i = usrConfigCrcFrom; i < USR_CONFIG_COUNT; i++)
+  {
+    uint8_t crc = crcTable[usrConfigCrcState[i] ^ (uint8_t)((usrConfigShadow[i] >> 8) & 0xFF)]; // Data MSB
+    if (i < (USR_CONFIG_COUNT - 1))
     {
-      // All other words: MSB then LSB
-      stream[idx++] = msb;
-      stream[idx++] = lsb;
+      crc = crcTable[crc ^ (uint8_t)(usrConfigShadow[i] & 0xFF)];                              // Data LSB, all but the last word
     }
+    usrConfigCrcState[i + 1] = crc;
   }
 
-   return CalcCRC(stream, idx, CONFIG_SEED);
+  usrConfigCrcFrom = USR_CONFIG_COUNT;
+
+  return (uint8_t)~usrConfigCrcState[USR_CONFIG_COUNT];
 }
 
  /**
  * Function for writing the CRC for the bitmap User Configuration block
+ * CRC computed from the shadow, CRC line written only if it changed
  */
 void WriteUserConfigCRC()
 {
-  uint8_t crc = CalcUserConfigCRC(USR_CONFIG_START_ADDRESS, USR_CONFIG_STOP_ADDRESS, true);           // Calculate CRC
-  uint16_t crcLine = (uint16_t)((SpiReadRegNextFrame(USR_CONFIG_STOP_ADDRESS, true) >> 8) & 0xFFFF);  // Read CRC line
+  if (usrConfigKnown != USR_CONFIG_ALL)
+  {
+    if (ShadowRefresh() == 0)                                                                         // Fill the shadow once
+    {
+      return;                                                                                         // Never write a CRC from an unknown shadow
+    }
+  }
+
+  uint8_t crc = CalcShadowConfigCRC();                                                                // Calculate CRC
+  uint16_t crcLine = usrConfigShadow[USR_CONFIG_COUNT - 1];                                           // CRC line from shadow
   crcLine = (uint16_t)((crcLine & 0xFF00) | crc);                                                     // Replace CRC and keep useful data
-  SpiWriteRegNextFrame(USR_CONFIG_STOP_ADDRESS, crcLine);                                             // Write new CRC
+  ShadowWriteRegNextFrame(USR_CONFIG_STOP_ADDRESS, crcLine);                                          // Write new CRC, if changed
 
   // Print data
   Serial.print("                        New CRC: 0x");
@@ -346,6 +571,8 @@ void setup()
   SPIInit();
   // Start serial communication with 115200 baud rate
   Serial.begin(115200);
+  // Read the user configuration area once, later writes skip unchanged registers
+  ShadowRefresh();
   Serial.println("Init Done...");
 }
 
@@ -394,8 +621,14 @@ void loop()
   Serial.print("CRC: 0x");
   Serial.println(responseCRC, HEX);
 
+  // Check frame - a corrupted angle is never decoded
+  if(!CheckResponse(responseFrame))
+  {
+    Serial.print("CRC ERROR - frame dropped, errors: ");
+    Serial.println(crcErrorCount);
+  }
   // Option to decode angle
-  if(DECODE_ANGLE)
+  else if(DECODE_ANGLE)
   {
     Serial.print("###########ANGLE[deg]: ");
     Serial.println(GetAngleDeg(responseData), 2);
@@ -408,27 +641,35 @@ void loop()
   Serial.println("");
   Serial.println("***WRITE EXAMPLE***");
 
-  // Unlock user registers for write access
-  SpiWriteRegNextFrame(UNLOCK_REG, USR_PASS);
+  // Write only if the register changes - shadow compare, no SPI traffic otherwise
+  if (!ShadowDiffers(USR_CONFIG_7_REG, 0x1001))
+  {
+    Serial.println("                        Data unchanged, write skipped");
+  }
+  else
+  {
+    // Unlock user registers for write access
+    SpiWriteRegNextFrame(UNLOCK_REG, USR_PASS);
 
-  // Disable CRC check for bitmap
-  SpiWriteRegNextFrame(STAT_EN_1_REG, CRC_BM_DIS);
+    // Disable CRC check for bitmap
+    SpiWriteRegNextFrame(STAT_EN_1_REG, CRC_BM_DIS);
 
-  // Write any USER register
-  temp = SpiWriteRegNextFrame(USR_CONFIG_7_REG, 0x1001);
-  Serial.print("                        Data before write: 0x");
-  temp = (temp >> 8) & 0xFFFF; // Display only data
-  Serial.println(temp, HEX);
+    // Write any USER register
+    Serial.print("                        Data before write: 0x");
+    Serial.println(usrConfigShadow[USR_CONFIG_7_REG - USR_CONFIG_START_ADDRESS], HEX);
+    ShadowWriteRegNextFrame(USR_CONFIG_7_REG, 0x1001);
 
-  temp = SpiReadRegNextFrame(USR_CONFIG_7_REG, true);
-  Serial.print("                        Data after write: 0x");
-  temp = (temp >> 8) & 0xFFFF; // Display only data
-  Serial.println(temp, HEX);
+    WriteUserConfigCRC(); // Update CRC - Mandatory for restart from VM, volatile data is lost in case of wrong CRC detection
 
-  WriteUserConfigCRC(); // Update CRC - Mandatory for restart from VM, volatile data is lost in case of wrong CRC detection
+    // Read back register and CRC line in one list
+    temp = ShadowVerify(true);
+    Serial.print("                        Data after write: 0x");
+    Serial.print(usrConfigShadow[USR_CONFIG_7_REG - USR_CONFIG_START_ADDRESS], HEX);
+    Serial.println(temp ? " (verified)" : " (MISMATCH)");
 
-  SpiWriteRegNextFrame(STAT_EN_REG, VAL_SOFT_RESET_NVM_DATA); // Restart from NVM - lose all volatile data
-  //SpiWriteRegNextFrame(STAT_EN_REG, VAL_SOFT_RESET_VM_DATA); // Restart from VM - keep all volatile data
+    SpiWriteRegNextFrame(STAT_EN_REG, VAL_SOFT_RESET_VM_DATA); // Restart from VM - keep all volatile data, shadow stays valid
+    //SpiWriteRegNextFrame(STAT_EN_REG, VAL_SOFT_RESET_NVM_DATA); ShadowInvalidate(); // Restart from NVM - lose all volatile data and the shadow
+  }
 
 
   // Readout delay - Can be changed
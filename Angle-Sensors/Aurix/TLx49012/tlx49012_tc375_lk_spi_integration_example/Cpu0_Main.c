@@ -30,6 +30,8 @@
  *              1.	SPI communication with the TLx49012 magnetic angle sensor.
  *              2.	CRC calculations
  *              3.	OneEye UI
+ *              4.	Acquisition on core 0, reporting on core 1, over a lock-free SPSC queue
+ *              5.	Harmonic angle-error compensation, fitted at start-up (TLX49012_COMPENSATION_ENABLE)
  *
  * \name TLx49012 TC375 LK SPI Integration Example
  * \version V1.0.0
@@ -52,11 +54,43 @@
 #include <stdio.h>
 
 #include "TLx49012.h"
+#include "spsc_queue.h"
+#include "Observer.h"
+
+/* Samples queued for the reporting core, power of two */
+#define SAMPLE_QUEUE_LENGTH     128
+
+/* Acquisition period, paced by the STM. 2 kHz as before the observer: at 1 MHz SCLK a blocking 32-bit frame
+ * alone takes over 32 us, and the report window and the compensation fit are sized for 500 us. The observer has no
+ * fixed rate - for a 20 kHz motor loop set 50 us here, with a faster SCLK, and a bandwidth up to about 200 Hz.
+ */
+#define SAMPLE_PERIOD_US        500                                         /* [us]                                 */
+
+/* Angle tracking observer: update period and closed-loop bandwidth */
+#define OBSERVER_SAMPLE_TIME    (SAMPLE_PERIOD_US * 1e-6f)                  /* [s], one update per STM period       */
+#define OBSERVER_BANDWIDTH      50.0f                                       /* [Hz]                                 */
 
 static float g_angle = 0;
+static float g_speed = 0;                                                   /* [deg/s], from the observer           */
+static float g_acceleration = 0;                                            /* [deg/s^2], from the observer         */
+static uint32 g_loopOverruns = 0;                                          /* Periods missed by the loop           */
 
 IFX_ALIGN(4) IfxCpu_syncEvent g_cpuSyncEvent = 0;
 
+/* Sample queue to core 1. Lives in the DSPR of this core: not cached, local to the producer and reached by the
+ * consumer over the SRI.
+ */
+IFX_ALIGN(SPSC_CACHE_LINE) SPSC_Queue g_sampleQueue;
+IFX_ALIGN(SPSC_CACHE_LINE) static TLx49012_Sample g_sampleSlots[SAMPLE_QUEUE_LENGTH];
+
+#if TLX49012_COMPENSATION_ENABLE
+/* Angle-error compensation, fitted once before acquisition starts */
+static TLx49012_Compensation g_compensation;
+#endif
+
+/* Set once the sensor is initialized - core 1 then takes the UART over */
+volatile boolean g_sampleQueueReady = FALSE;
+
 void core0_main(void)
 {
     IfxCpu_enableInterrupts();
@@ -80,20 +114,66 @@ void core0_main(void)
     /* Initialise the Sensor */
     TLx49012_Init();
 
+#if TLX49012_COMPENSATION_ENABLE
+    /* Fit the angle-error compensation - unfitted it leaves the angle as read */
+    TLx49012_CalibrateCompensation(&g_compensation);
+#endif
 
-    while(1)
-    {
-        /* Get Angle */
-        double Angle = TLx49012_GetAngleDegrees();
+    /* Initialization messages out before core 1 takes the UART over */
+    UART_flush();
+
+    /* Acquisition only from here on, reporting runs on core 1 */
+    SPSC_init(&g_sampleQueue, g_sampleSlots, sizeof(TLx49012_Sample), SAMPLE_QUEUE_LENGTH);
+    g_sampleQueueReady = TRUE;
 
-        /* Rounding for OneEye UI display */
-        g_angle = (int)(Angle * 100) / 100.0f;
+    /* Observer starts at rest at the first angle */
+    TLx49012_Observer observer;
+    TLx49012_ObserverOutput tracked;
+    TLx49012_Sample sample;
+    uint32 period = TIME_ticks_us(SAMPLE_PERIOD_US);
+    uint32 deadline = TIME_now();
 
-        /* Print out the global variables through the UART channel */
-        TLx49012_PrintSerialData();
+    TLx49012_GetSample(&sample);
+#if TLX49012_COMPENSATION_ENABLE
+    sample.angleRaw = TLx49012_CompensationApply(&g_compensation, sample.angleRaw);
+#endif
+    TLx49012_ObserverInit(&observer, OBSERVER_SAMPLE_TIME, OBSERVER_BANDWIDTH, sample.angleRaw);
 
-        /* Delay for sample rate control */
-        TIME_wait_us(500);                          // Wait x
+    while(1)
+    {
+        /* Sample rate from the STM: each read starts one period after the previous one, however long the pass
+         * took, so the observer period is OBSERVER_SAMPLE_TIME and not the period plus the loop body.
+         */
+        deadline += period;
+        while(FALSE == TIME_wait_until(deadline))
+        {
+            /* Pass overran - one prediction per missed period keeps the observer on time */
+            TLx49012_ObserverUpdate(&observer, sample.angleRaw, FALSE, &tracked);
+            g_loopOverruns++;
+            deadline += period;
+        }
+
+        /* Get Angle - a response failing the CRC or status check keeps the last valid frame */
+        boolean valid = TLx49012_GetSample(&sample);
+
+#if TLX49012_COMPENSATION_ENABLE
+        /* Correction table lookup - also on a failed read, which repeats the last valid raw angle */
+        sample.angleRaw = TLx49012_CompensationApply(&g_compensation, sample.angleRaw);
+#endif
+
+        /* Speed and acceleration - a failed read only advances the observer */
+        TLx49012_ObserverUpdate(&observer, sample.angleRaw, valid, &tracked);
+        g_speed = tracked.speed;
+        g_acceleration = tracked.acceleration;
+
+        if(valid)
+        {
+            /* Rounding for OneEye UI display */
+            g_angle = (int)((sample.angleRaw * 360.0f) / 65536 * 100) / 100.0f;
+        }
+
+        /* Hand the sample to core 1 - on a full queue it is counted and dropped */
+        SPSC_push(&g_sampleQueue, &sample);
     }
 }
 
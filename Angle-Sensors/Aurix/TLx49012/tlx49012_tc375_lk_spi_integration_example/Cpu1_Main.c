@@ -28,8 +28,15 @@
 #include "IfxCpu.h"
 #include "IfxScuWdt.h"
 
+#include "uart.h"
+#include "spsc_queue.h"
+#include "TLx49012.h"
+
 extern IfxCpu_syncEvent g_cpuSyncEvent;
 
+extern SPSC_Queue g_sampleQueue;
+extern volatile boolean g_sampleQueueReady;
+
 void core1_main(void)
 {
     IfxCpu_enableInterrupts();
@@ -43,7 +50,35 @@ void core1_main(void)
     IfxCpu_emitEvent(&g_cpuSyncEvent);
     IfxCpu_waitEvent(&g_cpuSyncEvent, 1);
     
+    /* Core 0 prints the sensor initialization, then hands the UART over */
+    while(!g_sampleQueueReady)
+    {
+    }
+
+    /* TX interrupt moves to this core */
+    UART_init();
+
+    TLx49012_Window window;
+    uint32 overflowsReported = 0;
+
+    TLx49012_WindowInit(&window, TLX49012_WINDOW_SAMPLES);
+
     while(1)
     {
+        TLx49012_Sample sample;
+
+        /* Every sample goes into the window, one report per window */
+        while(SPSC_pop(&g_sampleQueue, &sample))
+        {
+            if(TLx49012_WindowAdd(&window, &sample))
+            {
+                /* Drops of this window only, the queue counts since start */
+                uint32 overflows = g_sampleQueue.overflows;
+
+                TLx49012_PrintWindow(&window, overflows - overflowsReported);
+                overflowsReported = overflows;
+                TLx49012_WindowInit(&window, TLX49012_WINDOW_SAMPLES);
+            }
+        }
     }
 }
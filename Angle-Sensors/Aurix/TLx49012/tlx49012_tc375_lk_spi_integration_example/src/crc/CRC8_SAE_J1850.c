@@ -32,6 +32,10 @@
 #include "CRC8_SAE_J1850.h"
 #include "IfxPort.h"
 
+/* The CRC tables of the project live here */
+#define XENSIV_CRC_DEFINE_TABLES
+#include "xensiv_crc.h"
+
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
 /*********************************************************************************************************************/
@@ -43,8 +47,6 @@
 /*********************************************************************************************************************/
 /*--------------------------------------------Private Variables/Constants--------------------------------------------*/
 /*********************************************************************************************************************/
-// CRC LUT
-uint8 crcTable[256];
 
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
@@ -53,25 +55,8 @@ uint8 crcTable[256];
 /*********************************************************************************************************************/
 /*---------------------------------------------Function Implementations----------------------------------------------*/
 /*********************************************************************************************************************/
-uint8 CalcCRC(uint8 * buf, uint8 len)
-{
-    const uint8 * ptr = buf;
-    uint8 _crc = 0xFF;
-
-    while(len--) _crc = crcTable[_crc ^ *ptr++];
-
-    return ~_crc;
-}
-
-void CRCInit(void)
+uint8 CalcCRC(const uint8 * buf, uint8 len)
 {
-    uint8 _crc;
-    for (int i = 0; i < 0x100; i++)
-    {
-        _crc = i;
-
-        for (uint8 bit = 0; bit < 8; bit++) _crc = (_crc & 0x80) ? ((_crc << 1) ^ 0x1D) : (_crc << 1);
-
-        crcTable[i] = _crc;
-    }
+    /* LUT is generated at compile time by the shared CRC library */
+    return xensiv_crc8_j1850(buf, len, XENSIV_CRC8_J1850_SEED_SPI);
 }
@@ -52,7 +52,6 @@
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
-uint8 CalcCRC(uint8 * buf, uint8 len);
-void CRCInit(void);
+uint8 CalcCRC(const uint8 * buf, uint8 len);
 
 #endif /* SRC_CRC_CRC8_SAE_J1850_H_ */
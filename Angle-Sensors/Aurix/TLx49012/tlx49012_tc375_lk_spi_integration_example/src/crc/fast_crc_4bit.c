@@ -31,6 +31,7 @@
 /*********************************************************************************************************************/
 
 #include "fast_crc_4bit.h"
+#include "xensiv_crc.h"
 
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
@@ -38,15 +39,6 @@
 
 #define CRC_SEED    5 // CRC seed value
 
-/*********************************************************************************************************************/
-/*--------------------------------------------Private Variables/Constants--------------------------------------------*/
-/*********************************************************************************************************************/
-
-/**
- * FAST CRC 4bit LUT
- */
-const uint8_t CRC4_TABLE[16] = { 0, 13, 7, 10, 14, 3, 9, 4, 1, 12, 6, 11, 15, 2, 8, 5 };
-
 /*********************************************************************************************************************/
 /*---------------------------------------------Function Implementations----------------------------------------------*/
 /*********************************************************************************************************************/
@@ -58,15 +50,6 @@ const uint8_t CRC4_TABLE[16] = { 0, 13, 7, 10, 14, 3, 9, 4, 1, 12, 6, 11, 15, 2,
  */
 uint8_t CRC_CalculateCRC(uint8_t nibbleValues[], uint8_t nibbleCount)
 {
-  uint8_t crc       = CRC_SEED;                         // Seed value
-
-  for(uint8_t i = 0; i < nibbleCount - 1; i++)
-  {
-    crc = (uint8_t)(nibbleValues[i] ^ CRC4_TABLE[crc]);
-  }
-  crc = (uint8_t)(0x0 ^ CRC4_TABLE[crc]);               // Final XOR
-
-  return crc;
+  // Last nibble is the received CRC and is not part of the calculation
+  return xensiv_crc4_sent(nibbleValues, (uint8_t)(nibbleCount - 1), CRC_SEED);
 }
-
-
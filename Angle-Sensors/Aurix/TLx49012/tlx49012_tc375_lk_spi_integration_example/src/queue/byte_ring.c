@@ -0,0 +1,157 @@
+/**********************************************************************************************************************
+ * \file byte_ring.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "byte_ring.h"
+
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+void RING_init(RING_Buffer *ring, uint8_t *storage, uint32_t size)
+{
+    ring->head = 0;
+    ring->highWater = 0;
+    ring->tail = 0;
+
+    ring->data = storage;
+    ring->mask = size - 1;
+
+    /* Ring complete before it is handed to the other side */
+    SPSC_BARRIER();
+}
+
+
+uint32_t RING_write(RING_Buffer *ring, const uint8_t *data, uint32_t count)
+{
+    uint32_t head = ring->head;
+    uint32_t used = head - ring->tail;
+    uint32_t room = ring->mask + 1 - used;
+    uint32_t offset = head & ring->mask;
+    uint32_t first;
+
+    if(count > room)
+    {
+        count = room;
+    }
+
+    if(count == 0)
+    {
+        return 0;
+    }
+
+    /* Bytes freed by the consumer are read out before they are overwritten */
+    SPSC_BARRIER();
+
+    /* Up to the end of the storage, then the rest from its start */
+    first = ring->mask + 1 - offset;
+    if(first > count)
+    {
+        first = count;
+    }
+
+    memcpy(&ring->data[offset], data, first);
+    memcpy(&ring->data[0], &data[first], count - first);
+
+    /* Bytes written before they are published */
+    SPSC_BARRIER();
+    ring->head = head + count;
+
+    if((used + count) > ring->highWater)
+    {
+        ring->highWater = used + count;
+    }
+
+    return count;
+}
+
+
+uint32_t RING_writeAll(RING_Buffer *ring, const uint8_t *data, uint32_t count)
+{
+    /* Only the producer shrinks the room, so what fits now still fits in RING_write() */
+    if(RING_free(ring) < count)
+    {
+        return 0;
+    }
+
+    return RING_write(ring, data, count);
+}
+
+
+uint32_t RING_read(RING_Buffer *ring, uint8_t *data, uint32_t count)
+{
+    uint32_t tail = ring->tail;
+    uint32_t used = ring->head - tail;
+    uint32_t offset = tail & ring->mask;
+    uint32_t first;
+
+    if(count > used)
+    {
+        count = used;
+    }
+
+    if(count == 0)
+    {
+        return 0;
+    }
+
+    /* Bytes published before head are visible */
+    SPSC_BARRIER();
+
+    first = ring->mask + 1 - offset;
+    if(first > count)
+    {
+        first = count;
+    }
+
+    memcpy(data, &ring->data[offset], first);
+    memcpy(&data[first], &ring->data[0], count - first);
+
+    /* Bytes read out before their room is handed back */
+    SPSC_BARRIER();
+    ring->tail = tail + count;
+
+    return count;
+}
+
+
+uint32_t RING_used(const RING_Buffer *ring)
+{
+    return ring->head - ring->tail;
+}
+
+
+uint32_t RING_free(const RING_Buffer *ring)
+{
+    return ring->mask + 1 - (ring->head - ring->tail);
+}
@@ -0,0 +1,91 @@
+/**********************************************************************************************************************
+ * \file byte_ring.h
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+#ifndef SRC_QUEUE_BYTE_RING_H_
+#define SRC_QUEUE_BYTE_RING_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "spsc_queue.h"                                                     /* SPSC_CACHE_LINE, SPSC_BARRIER()      */
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Lock-free single producer, single consumer byte ring, e.g. a task writing and an interrupt draining.
+ * Head and tail run freely and are masked on access, the ring holds size bytes. Unlike SPSC_Queue it moves byte
+ * blocks of any length, split in two copies where they wrap.
+ */
+typedef struct
+{
+    /* Producer line */
+    volatile uint32_t head;                                                 /* Next byte to write                   */
+    uint32_t highWater;                                                     /* Most bytes held so far               */
+    uint8_t producerPad[SPSC_CACHE_LINE - 2 * sizeof(uint32_t)];
+
+    /* Consumer line */
+    volatile uint32_t tail;                                                 /* Next byte to read                    */
+    uint8_t consumerPad[SPSC_CACHE_LINE - sizeof(uint32_t)];
+
+    /* Read-only after RING_init() */
+    uint8_t *data;
+    uint32_t mask;
+} RING_Buffer;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*! \brief Initializes an empty ring on size bytes of storage, size a power of two */
+void RING_init(RING_Buffer *ring, uint8_t *storage, uint32_t size);
+
+
+/*! \brief Producer side. Copies as many of count bytes as fit, returns how many */
+uint32_t RING_write(RING_Buffer *ring, const uint8_t *data, uint32_t count);
+
+
+/*! \brief Producer side. Copies all count bytes if they fit, otherwise none, returns how many */
+uint32_t RING_writeAll(RING_Buffer *ring, const uint8_t *data, uint32_t count);
+
+
+/*! \brief Consumer side. Copies up to count of the oldest bytes out, returns how many */
+uint32_t RING_read(RING_Buffer *ring, uint8_t *data, uint32_t count);
+
+
+/*! \brief Bytes held. The other side may move on meanwhile: at most this many on the producer side, at least on the
+ *         consumer side.
+ */
+uint32_t RING_used(const RING_Buffer *ring);
+
+
+/*! \brief Room left, at least this much on the producer side */
+uint32_t RING_free(const RING_Buffer *ring);
+
+
+#endif /* SRC_QUEUE_BYTE_RING_H_ */
@@ -0,0 +1,113 @@
+/**********************************************************************************************************************
+ * \file spsc_queue.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "spsc_queue.h"
+
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+void SPSC_init(SPSC_Queue *queue, void *slots, uint32_t slotSize, uint32_t slotCount)
+{
+    queue->head = 0;
+    queue->tailCache = 0;
+    queue->overflows = 0;
+
+    queue->tail = 0;
+    queue->headCache = 0;
+
+    queue->slots = (uint8_t *)slots;
+    queue->slotSize = slotSize;
+    queue->mask = slotCount - 1;
+
+    /* Queue complete before it is handed to the other side */
+    SPSC_BARRIER();
+}
+
+
+bool SPSC_push(SPSC_Queue *queue, const void *item)
+{
+    uint32_t head = queue->head;
+
+    /* Looks full: fetch the tail the consumer has reached since */
+    if((head - queue->tailCache) > queue->mask)
+    {
+        queue->tailCache = queue->tail;
+
+        if((head - queue->tailCache) > queue->mask)
+        {
+            queue->overflows++;
+            return false;
+        }
+
+        /* Slots released by the consumer are read out before they are overwritten */
+        SPSC_BARRIER();
+    }
+
+    memcpy(&queue->slots[(head & queue->mask) * queue->slotSize], item, queue->slotSize);
+
+    /* Item written before it is published */
+    SPSC_BARRIER();
+    queue->head = head + 1;
+
+    return true;
+}
+
+
+bool SPSC_pop(SPSC_Queue *queue, void *item)
+{
+    uint32_t tail = queue->tail;
+
+    /* Looks empty: fetch the head the producer has reached since */
+    if(tail == queue->headCache)
+    {
+        queue->headCache = queue->head;
+
+        if(tail == queue->headCache)
+        {
+            return false;
+        }
+
+        /* Items published before head are visible */
+        SPSC_BARRIER();
+    }
+
+    memcpy(item, &queue->slots[(tail & queue->mask) * queue->slotSize], queue->slotSize);
+
+    /* Item read out before the slot is handed back */
+    SPSC_BARRIER();
+    queue->tail = tail + 1;
+
+    return true;
+}
@@ -0,0 +1,108 @@
+/**********************************************************************************************************************
+ * \file spsc_queue.h
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+#ifndef SRC_QUEUE_SPSC_QUEUE_H_
+#define SRC_QUEUE_SPSC_QUEUE_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Data cache line of the TC3xx cores. Producer and consumer indices sit on lines of their own, so that neither
+ * side writes to a line the other one keeps reading. Raise it to 64 for the host build on x86.
+ */
+#ifndef SPSC_CACHE_LINE
+#define SPSC_CACHE_LINE         32
+#endif
+
+/* Orders the slot accesses against the index updates. The queue is plain C otherwise, other targets only have to
+ * supply their barrier here.
+ */
+#ifndef SPSC_BARRIER
+#if defined(__linux__)
+#define SPSC_BARRIER()          __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#include "Ifx_Types.h"
+#define SPSC_BARRIER()          __dsync()
+#endif
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Lock-free single producer, single consumer queue of fixed size items.
+ * Head and tail run freely and are masked on access, the queue holds slotCount items.
+ * Each side keeps a copy of the other side's index and reads the shared one only when the queue looks full or empty,
+ * so a core mostly works on its own line. Place the queue and its slots in memory both cores see uncached, e.g. the
+ * DSPR of the producer core, and align both on SPSC_CACHE_LINE.
+ */
+typedef struct
+{
+    /* Producer line */
+    volatile uint32_t head;                                                 /* Next slot to write                   */
+    uint32_t tailCache;                                                     /* Tail as last seen by the producer    */
+    volatile uint32_t overflows;                                            /* Items dropped on a full queue        */
+    uint8_t producerPad[SPSC_CACHE_LINE - 3 * sizeof(uint32_t)];
+
+    /* Consumer line */
+    volatile uint32_t tail;                                                 /* Next slot to read                    */
+    uint32_t headCache;                                                     /* Head as last seen by the consumer    */
+    uint8_t consumerPad[SPSC_CACHE_LINE - 2 * sizeof(uint32_t)];
+
+    /* Read-only after SPSC_init() */
+    uint8_t *slots;
+    uint32_t slotSize;
+    uint32_t mask;
+} SPSC_Queue;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*! \brief Initializes an empty queue on slotCount slots of slotSize bytes, slotCount a power of two.
+ *         Call it before either side uses the queue.
+ */
+void SPSC_init(SPSC_Queue *queue, void *slots, uint32_t slotSize, uint32_t slotCount);
+
+
+/*! \brief Producer side. Copies an item into the queue, or counts an overflow and returns false if it is full */
+bool SPSC_push(SPSC_Queue *queue, const void *item);
+
+
+/*! \brief Consumer side. Copies the oldest item out of the queue, returns false if it is empty */
+bool SPSC_pop(SPSC_Queue *queue, void *item);
+
+
+#endif /* SRC_QUEUE_SPSC_QUEUE_H_ */
@@ -0,0 +1,267 @@
+/**********************************************************************************************************************
+ * \file test_byte_ring.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+/* Host (Linux) test of RING_Buffer, see the Makefile in this folder. Not part of the AURIX build.
+ * Single-threaded first: blocks wrapping around the end of the storage, a full ring taking part of a block, the whole
+ * block or nothing of RING_writeAll() that UART_TX_POLICY_DROP relies on, and the high-water mark. Then a producer
+ * and a consumer thread pass a numbered byte stream in blocks of random length, as UART_send_buf() and the TX
+ * interrupt do, and the consumer checks every byte.
+ */
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "byte_ring.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_RING_SIZE          1024u
+#define TEST_STREAM_BYTES       20000000u
+#define TEST_BLOCK_MAX          300u                                        /* Longest message of the producer      */
+#define TEST_READ_MAX           16u                                         /* TX FIFO room of the consumer         */
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static RING_Buffer g_ring __attribute__((aligned(SPSC_CACHE_LINE)));
+static uint8_t g_storage[TEST_RING_SIZE];
+static uint32_t g_failures;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void check(bool passed, const char *what)
+{
+    if(!passed)
+    {
+        g_failures++;
+        printf("FAIL: %s\n", what);
+    }
+}
+
+
+static uint8_t streamByte(uint32_t index)
+{
+    return (uint8_t)((index * 7u) ^ (index >> 8));
+}
+
+
+static uint32_t nextRandom(uint32_t *state)
+{
+    *state = (*state * 1103515245u) + 12345u;
+
+    return *state >> 16;
+}
+
+
+static void testWrap(void)
+{
+    uint8_t out[8];
+    uint8_t in[8];
+
+    /* 8-byte ring moved on by 5, so the next 6 bytes wrap after 3 */
+    RING_init(&g_ring, g_storage, 8);
+    memset(in, 0xEE, sizeof(in));
+    check(RING_write(&g_ring, in, 5) == 5, "write before the wrap");
+    check(RING_read(&g_ring, out, 5) == 5, "read before the wrap");
+
+    for(uint32_t i = 0; i < 6; i++)
+    {
+        in[i] = streamByte(i);
+    }
+    check(RING_write(&g_ring, in, 6) == 6, "write across the end");
+    check((g_storage[5] == in[0]) && (g_storage[7] == in[2]) && (g_storage[0] == in[3]), "wrapped block placement");
+    check(RING_read(&g_ring, out, sizeof(out)) == 6, "read across the end");
+    check(memcmp(in, out, 6) == 0, "bytes changed across the end");
+    check(RING_used(&g_ring) == 0, "ring not empty after reading everything");
+}
+
+
+static void testFull(void)
+{
+    uint8_t block[12];
+    uint8_t out[12];
+
+    RING_init(&g_ring, g_storage, 8);
+    for(uint32_t i = 0; i < sizeof(block); i++)
+    {
+        block[i] = streamByte(i);
+    }
+
+    check(RING_write(&g_ring, block, 12) == 8, "full ring takes the bytes that fit");
+    check((RING_free(&g_ring) == 0) && (RING_used(&g_ring) == 8), "fill level of a full ring");
+    check(RING_write(&g_ring, block, 1) == 0, "full ring takes another byte");
+    check(RING_read(&g_ring, out, sizeof(out)) == 8, "read of a full ring");
+    check(memcmp(block, out, 8) == 0, "bytes of a full ring changed");
+    check(RING_read(&g_ring, out, sizeof(out)) == 0, "read of an empty ring");
+}
+
+
+static void testDrop(void)
+{
+    uint8_t block[8];
+    uint8_t out[8];
+
+    /* The UART_TX_POLICY_DROP case: 6 bytes held, a 3-byte message does not fit and must leave no trace */
+    RING_init(&g_ring, g_storage, 8);
+    for(uint32_t i = 0; i < sizeof(block); i++)
+    {
+        block[i] = streamByte(i);
+    }
+
+    check(RING_writeAll(&g_ring, block, 6) == 6, "whole write with room");
+    check(RING_writeAll(&g_ring, &block[6], 3) == 0, "whole write without room");
+    check(RING_used(&g_ring) == 6, "dropped write left bytes in the ring");
+    check(RING_writeAll(&g_ring, &block[6], 2) == 2, "whole write filling the ring exactly");
+    check(RING_read(&g_ring, out, sizeof(out)) == 8, "read after the drop");
+    check(memcmp(block, out, 8) == 0, "bytes changed around the drop");
+    check(RING_writeAll(&g_ring, block, 9) == 0, "whole write longer than the ring");
+    check(RING_writeAll(&g_ring, block, 0) == 0, "empty whole write");
+}
+
+
+static void testHighWater(void)
+{
+    uint8_t block[8] = { 0 };
+    uint8_t out[8];
+
+    RING_init(&g_ring, g_storage, 8);
+    check(g_ring.highWater == 0, "high-water mark of a new ring");
+
+    RING_write(&g_ring, block, 3);
+    RING_write(&g_ring, block, 2);
+    check(g_ring.highWater == 5, "high-water mark after two writes");
+
+    /* Reads never lower it, only a fuller ring raises it */
+    RING_read(&g_ring, out, 4);
+    RING_write(&g_ring, block, 3);
+    check(g_ring.highWater == 5, "high-water mark changed below its level");
+
+    RING_write(&g_ring, block, 8);
+    check(g_ring.highWater == 8, "high-water mark of a full ring");
+
+    RING_writeAll(&g_ring, block, 1);
+    check(g_ring.highWater == 8, "dropped write changed the high-water mark");
+}
+
+
+static void *producer(void *arg)
+{
+    uint8_t block[TEST_BLOCK_MAX];
+    uint32_t state = 1;
+    uint32_t written = 0;
+
+    (void)arg;
+
+    while(written < TEST_STREAM_BYTES)
+    {
+        uint32_t count = 1 + (nextRandom(&state) % TEST_BLOCK_MAX);
+
+        if(count > (TEST_STREAM_BYTES - written))
+        {
+            count = TEST_STREAM_BYTES - written;
+        }
+
+        for(uint32_t i = 0; i < count; i++)
+        {
+            block[i] = streamByte(written + i);
+        }
+
+        /* Whole blocks as with UART_TX_POLICY_DROP, but retried instead of dropped */
+        while(RING_writeAll(&g_ring, block, count) == 0)
+        {
+            sched_yield();
+        }
+        written += count;
+    }
+
+    return NULL;
+}
+
+
+static void testThreads(void)
+{
+    pthread_t thread;
+    uint8_t chunk[TEST_READ_MAX];
+    uint32_t state = 7;
+    uint32_t received = 0;
+
+    RING_init(&g_ring, g_storage, TEST_RING_SIZE);
+    pthread_create(&thread, NULL, producer, NULL);
+
+    while(received < TEST_STREAM_BYTES)
+    {
+        uint32_t count = RING_read(&g_ring, chunk, 1 + (nextRandom(&state) % TEST_READ_MAX));
+
+        for(uint32_t i = 0; i < count; i++)
+        {
+            if(chunk[i] != streamByte(received + i))
+            {
+                printf("FAIL: byte %u of the stream differs\n", received + i);
+                g_failures++;
+                received = TEST_STREAM_BYTES;
+                break;
+            }
+        }
+        received += count;
+
+        if(count == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    pthread_join(thread, NULL);
+
+    check(g_ring.highWater <= TEST_RING_SIZE, "high-water mark above the ring size");
+    printf("RING_Buffer: %u bytes in order, high-water mark %u of %u\n", TEST_STREAM_BYTES, g_ring.highWater,
+           TEST_RING_SIZE);
+}
+
+
+int main(void)
+{
+    testWrap();
+    testFull();
+    testDrop();
+    testHighWater();
+    testThreads();
+
+    printf("%s: %u failures\n", g_failures ? "FAIL" : "PASS", g_failures);
+
+    return g_failures ? 1 : 0;
+}
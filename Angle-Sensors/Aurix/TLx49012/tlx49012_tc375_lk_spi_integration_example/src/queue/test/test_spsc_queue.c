@@ -0,0 +1,199 @@
+/**********************************************************************************************************************
+ * \file test_spsc_queue.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+/* Host (Linux) test of SPSC_Queue, see the Makefile in this folder. Not part of the AURIX build.
+ * A producer and a consumer thread pass numbered items through the queue, both retrying on full and empty, for as
+ * long as it takes. The consumer checks that every item arrives once, in order and intact, and the throughput is
+ * printed. The full and empty edges are checked on a small queue first.
+ */
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "spsc_queue.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <time.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_ITEMS              20000000u
+#define TEST_SLOTS              128u
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Same size as a TLx49012 sample: sequence number and a payload derived from it */
+typedef struct
+{
+    uint32_t sequence;
+    uint16_t angle;
+    uint8_t status;
+    uint8_t check;
+} Test_Item;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static SPSC_Queue g_queue __attribute__((aligned(SPSC_CACHE_LINE)));
+static Test_Item g_slots[TEST_SLOTS] __attribute__((aligned(SPSC_CACHE_LINE)));
+static uint32_t g_failures;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static Test_Item makeItem(uint32_t sequence)
+{
+    Test_Item item = { sequence, (uint16_t)(sequence * 40503u), (uint8_t)(sequence >> 16), 0 };
+
+    item.check = (uint8_t)(item.sequence ^ item.angle ^ item.status ^ 0xA5u);
+
+    return item;
+}
+
+
+static void check(bool passed, const char *what)
+{
+    if(!passed)
+    {
+        g_failures++;
+        printf("FAIL: %s\n", what);
+    }
+}
+
+
+static void testEdges(void)
+{
+    Test_Item item = makeItem(0);
+    uint32_t count = 0;
+
+    SPSC_init(&g_queue, g_slots, sizeof(Test_Item), 4);
+
+    check(!SPSC_pop(&g_queue, &item), "pop from an empty queue");
+
+    while(SPSC_push(&g_queue, &item))
+    {
+        count++;
+    }
+    check(count == 4, "capacity differs from the slot count");
+    check(g_queue.overflows == 1, "push to a full queue not counted as overflow");
+
+    while(SPSC_pop(&g_queue, &item))
+    {
+        count--;
+    }
+    check(count == 0, "items lost on the way through the small queue");
+}
+
+
+static void *producer(void *arg)
+{
+    (void)arg;
+
+    for(uint32_t sequence = 0; sequence < TEST_ITEMS; )
+    {
+        Test_Item item = makeItem(sequence);
+
+        if(SPSC_push(&g_queue, &item))
+        {
+            sequence++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+
+static void testThroughput(void)
+{
+    pthread_t thread;
+    struct timespec start, end;
+    uint32_t expected = 0;
+    double seconds;
+
+    SPSC_init(&g_queue, g_slots, sizeof(Test_Item), TEST_SLOTS);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&thread, NULL, producer, NULL);
+
+    while(expected < TEST_ITEMS)
+    {
+        Test_Item item, reference;
+
+        if(!SPSC_pop(&g_queue, &item))
+        {
+            sched_yield();
+            continue;
+        }
+
+        if(item.sequence != expected)
+        {
+            printf("FAIL: item %u arrived as item %u\n", expected, item.sequence);
+            g_failures++;
+            break;
+        }
+
+        reference = makeItem(expected);
+        if((item.angle != reference.angle) || (item.status != reference.status) || (item.check != reference.check))
+        {
+            printf("FAIL: item %u torn\n", expected);
+            g_failures++;
+            break;
+        }
+        expected++;
+    }
+
+    pthread_join(thread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+    printf("SPSC_Queue: %u items in order, %.1f Mitems/s, %u full queue retries\n",
+           expected, (expected / seconds) / 1e6, g_queue.overflows);
+}
+
+
+int main(void)
+{
+    testEdges();
+    testThroughput();
+
+    printf("%s: %u failures\n", g_failures ? "FAIL" : "PASS", g_failures);
+
+    return g_failures ? 1 : 0;
+}
@@ -48,3 +48,30 @@ void TIME_wait_ms(uint32_t ms)
 {
     waitTime(IfxStm_getTicksFromMilliseconds(BSP_DEFAULT_TIMER, ms));
 }
+
+/* --- Deadline functions --- */
+
+uint32_t TIME_ticks_us(uint32_t us)
+{
+    return (uint32_t)IfxStm_getTicksFromMicroseconds(BSP_DEFAULT_TIMER, us);
+}
+
+uint32_t TIME_now(void)
+{
+    return IfxStm_getLower(BSP_DEFAULT_TIMER);
+}
+
+bool TIME_wait_until(uint32_t deadline)
+{
+    /* Signed difference, valid across the 32-bit wrap for deadlines less than half the range away */
+    if((int32_t)(deadline - IfxStm_getLower(BSP_DEFAULT_TIMER)) <= 0)
+    {
+        return false;
+    }
+
+    while((int32_t)(deadline - IfxStm_getLower(BSP_DEFAULT_TIMER)) > 0)
+    {
+    }
+
+    return true;
+}
@@ -45,4 +45,13 @@ void TIME_wait_us(uint32_t us);
 // Wait for given milliseconds
 void TIME_wait_ms(uint32_t ms);
 
+// STM ticks in given microseconds, for periods and deadlines
+uint32_t TIME_ticks_us(uint32_t us);
+
+// Current STM time in ticks, lower 32 bits
+uint32_t TIME_now(void);
+
+// Wait until the STM reaches the deadline, false if it had already passed
+bool TIME_wait_until(uint32_t deadline);
+
 #endif /* SRC_TC375_TIME_TIME_H_ */
@@ -31,31 +31,43 @@
 /*********************************************************************************************************************/
 
 #include "uart.h"
+#include "byte_ring.h"
 
 
 #include "IfxAsclin_Asc.h"
 #include "IfxCpu_Irq.h"
+#include "IfxSrc.h"
 
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
 /*********************************************************************************************************************/
 
+#define ASC_TX_FIFO_SIZE        16                                          /* ASCLIN hardware TX FIFO in bytes     */
+
 /*********************************************************************************************************************/
 /*-------------------------------------------------Global variables--------------------------------------------------*/
 /*********************************************************************************************************************/
 
 IfxAsclin_Asc g_asc;                                                        /* Declaration of the ASC handle        */
 
-/* The transfer buffers allocate memory for the data itself and for FIFO runtime variables.
- * 8 more bytes have to be added to ensure a proper circular buffer handling independent from
- * the address to which the buffers have been located.
- */
-uint8 g_ascTxBuffer[ASC_TX_BUFFER_SIZE + sizeof(Ifx_Fifo) + 8];             /* Declaration of the FIFOs parameters  */
-
 /*********************************************************************************************************************/
 /*--------------------------------------------Private Variables/Constants--------------------------------------------*/
 /*********************************************************************************************************************/
 
+/* Bytes on their way to the TX FIFO: UART_send_buf() writes, the TX interrupt reads. Both run on the core owning
+ * the UART, the driver FIFO above is left unused.
+ */
+static RING_Buffer g_uartTxRing;
+static uint8 g_uartTxStorage[UART_TX_RING_SIZE];
+
+/* IfxAsclin_Asc_initModule() sets up a TX FIFO in any case, which nothing writes to. It gets the least the driver
+ * accepts: one 32-bit word, plus the FIFO runtime variables and 8 bytes to align the data whatever the address.
+ */
+static uint8 g_ascTxBuffer[ASC_TX_BUFFER_SIZE + sizeof(Ifx_Fifo) + 8];
+
+static uint32 g_uartDroppedMessages = 0;
+static uint32 g_uartDroppedBytes = 0;
+
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
@@ -65,10 +77,34 @@ uint8 g_ascTxBuffer[ASC_TX_BUFFER_SIZE + sizeof(Ifx_Fifo) + 8];             /* D
 /*********************************************************************************************************************/
 
 IFX_INTERRUPT(asclin0_Tx_ISR, 0, INTPRIO_ASCLIN0_TX);                       /* Adding the Interrupt Service Routine */
+IFX_INTERRUPT(asclin0_Tx_Cpu1_ISR, 1, INTPRIO_ASCLIN0_TX);                  /* Same on core 1, see UART_init()      */
+
+/* Refills the TX FIFO from the TX ring. Raised once the FIFO has run empty, or by UART_send_buf() */
+static void UART_txRefill(void)
+{
+    uint8 chunk[ASC_TX_FIFO_SIZE];
+    uint32 room;
+    uint32 count;
+
+    IfxAsclin_clearTxFifoFillLevelFlag(g_asc.asclin);
+
+    room = ASC_TX_FIFO_SIZE - IfxAsclin_getTxFifoFillLevel(g_asc.asclin);
+    count = RING_read(&g_uartTxRing, chunk, room);
+
+    if(count > 0)
+    {
+        IfxAsclin_write8(g_asc.asclin, chunk, (Ifx_SizeT)count);
+    }
+}
 
 void asclin0_Tx_ISR(void)
 {
-    IfxAsclin_Asc_isrTransmit(&g_asc);
+    UART_txRefill();
+}
+
+void asclin0_Tx_Cpu1_ISR(void)
+{
+    UART_txRefill();
 }
 
 
@@ -100,19 +136,68 @@ void UART_init(void) {
     ascConfig.pins = &pins;
 
     IfxAsclin_Asc_initModule(&g_asc, &ascConfig);           /* Initialize module with above parameters  */
+
+    /* Start with an empty TX ring */
+    RING_init(&g_uartTxRing, g_uartTxStorage, UART_TX_RING_SIZE);
+    g_uartDroppedMessages = 0;
+    g_uartDroppedBytes = 0;
 }
 
 
 int32_t UART_send_buf(void *data, int16_t count) {
-    Ifx_SizeT tx_length = count;
+    const uint8 *bytes = (const uint8 *)data;
+    uint32 queued = 0;
 
-    /* Transmit data via TX */
-    int32_t result = IfxAsclin_Asc_write(&g_asc, data, &tx_length, TIME_INFINITE);
+    if(count <= 0)
+    {
+        return 0;
+    }
+
+#if UART_TX_POLICY == UART_TX_POLICY_DROP
+    /* Whole messages only, so the console never shows a cut line */
+    queued = RING_writeAll(&g_uartTxRing, bytes, (uint32)count);
+    if(queued == 0)
+    {
+        g_uartDroppedMessages++;
+        g_uartDroppedBytes += (uint32)count;
+        return 0;
+    }
+
+    /* Have the TX interrupt pick the bytes up, a FIFO still sending is only topped up */
+    IfxSrc_setRequest(IfxAsclin_getSrcPointerTx(g_asc.asclin));
+#else
+    while(queued < (uint32)count)
+    {
+        queued += RING_write(&g_uartTxRing, &bytes[queued], (uint32)count - queued);
+
+        /* Have the TX interrupt pick the bytes up, a FIFO still sending is only topped up */
+        IfxSrc_setRequest(IfxAsclin_getSrcPointerTx(g_asc.asclin));
+    }
+#endif
+
+    return (int32_t)queued;
+}
 
-    while (IfxAsclin_getTxFifoFillLevel((&g_asc)->asclin) > 0)
+
+void UART_flush(void) {
+    while((RING_used(&g_uartTxRing) > 0) || (IfxAsclin_getTxFifoFillLevel(g_asc.asclin) > 0))
         ;
+}
+
+
+uint32_t UART_getTxPending(void) {
+    return RING_used(&g_uartTxRing);
+}
+
+
+UART_TxStats UART_getTxStats(void) {
+    UART_TxStats stats;
+
+    stats.highWater = g_uartTxRing.highWater;
+    stats.droppedMessages = g_uartDroppedMessages;
+    stats.droppedBytes = g_uartDroppedBytes;
 
-    return result;
+    return stats;
 }
 
 
@@ -45,7 +45,17 @@
 
 #define INTPRIO_ASCLIN0_TX      19                                          /* Priority of the ISR                  */
 
-#define ASC_TX_BUFFER_SIZE      64                                          /* Definition of the buffer size        */
+#define ASC_TX_BUFFER_SIZE      4                                           /* Unused driver FIFO, its minimum      */
+
+#define UART_TX_RING_SIZE       1024                                        /* Software TX ring, power of two       */
+
+/* What UART_send_buf() does with a message that does not fit in the TX ring */
+#define UART_TX_POLICY_DROP     0                                           /* Drop it whole and count it           */
+#define UART_TX_POLICY_BLOCK    1                                           /* Wait for room, byte block by block   */
+
+#ifndef UART_TX_POLICY
+#define UART_TX_POLICY          UART_TX_POLICY_DROP
+#endif
 
 /*********************************************************************************************************************/
 /*-------------------------------------------------Global variables--------------------------------------------------*/
@@ -54,6 +64,14 @@
 /*********************************************************************************************************************/
 /*-------------------------------------------------Data Structures---------------------------------------------------*/
 /*********************************************************************************************************************/
+
+/* TX ring statistics since UART_init() */
+typedef struct
+{
+    uint32_t highWater;                                                     /* Most bytes waiting in the TX ring    */
+    uint32_t droppedMessages;                                               /* Messages dropped on a full ring      */
+    uint32_t droppedBytes;                                                  /* Bytes of the dropped messages        */
+} UART_TxStats;
  
 /*********************************************************************************************************************/
 /*--------------------------------------------Private Variables/Constants--------------------------------------------*/
@@ -63,12 +81,29 @@
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
 
-/*! \brief Initialize the UART peripheral */
+/*! \brief Initialize the UART peripheral. The TX interrupt runs on the calling core, 0 or 1, which is then the only
+ *         one to send. Calling it again from the other core hands the UART over once all data is out.
+ */
 void UART_init(void);
 
 
-/*! \brief Write count bytes from the data array to UART */
+/*! \brief Queue count bytes from the data array for UART, the TX interrupt sends them. Does not wait for the wire.
+ *         A message not fitting in the TX ring is dropped or waited for, see UART_TX_POLICY.
+ *         Returns the number of bytes queued, 0 if the message was dropped.
+ */
 int32_t UART_send_buf(void *data, int16_t count);
 
 
+/*! \brief Wait until all queued bytes have left the TX FIFO */
+void UART_flush(void);
+
+
+/*! \brief Bytes still waiting in the TX ring */
+uint32_t UART_getTxPending(void);
+
+
+/*! \brief TX ring statistics */
+UART_TxStats UART_getTxStats(void);
+
+
 #endif /* SRC_TC375_UART_UART_H_ */
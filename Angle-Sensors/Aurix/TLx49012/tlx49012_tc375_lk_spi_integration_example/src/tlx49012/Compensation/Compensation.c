@@ -0,0 +1,305 @@
+/**********************************************************************************************************************
+ * \file Compensation.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Compensation.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define COMP_REVOLUTION             65536
+#define COMP_TABLE_SHIFT            (16 - TLX49012_COMP_TABLE_BITS)
+
+/*********************************************************************************************************************/
+/*--------------------------------------------Private Variables/Constants--------------------------------------------*/
+/*********************************************************************************************************************/
+// sin() over a quarter revolution in Q15, 64 steps
+static const int16_t quarterSine[65] =
+{
+        0,   804,  1608,  2410,  3212,  4011,  4808,  5602,
+     6393,  7179,  7962,  8739,  9512, 10278, 11039, 11793,
+    12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+    18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+    23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+    27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+    30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+    32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+    32767
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+// sin() of a quarter-revolution position 0 to 0x4000, Q15, interpolated
+static int32_t quarterSineQ15(uint32_t position)
+{
+    uint32_t index = position >> 8;
+    int32_t fraction = (int32_t)(position & 0xFF);
+    int32_t lower;
+
+    if(index >= 64)
+    {
+        return quarterSine[64];
+    }
+
+    lower = quarterSine[index];
+    return lower + (((quarterSine[index + 1] - lower) * fraction) >> 8);
+}
+
+// sin() of an angle in LSB16, Q15
+static int32_t sineQ15(uint16_t angle)
+{
+    uint32_t position = angle & 0x3FFFU;
+
+    switch(angle >> 14)
+    {
+        case 0:  return quarterSineQ15(position);
+        case 1:  return quarterSineQ15(0x4000U - position);
+        case 2:  return -quarterSineQ15(position);
+        default: return -quarterSineQ15(0x4000U - position);
+    }
+}
+
+// cos() of an angle in LSB16, Q15
+static int32_t cosineQ15(uint16_t angle)
+{
+    return sineQ15((uint16_t)(angle + 0x4000U));
+}
+
+// Fitted error at an angle [1/16 LSB]
+static int32_t harmonicError(const TLx49012_Compensation *comp, uint16_t angle)
+{
+    int64_t sum = 0;
+    uint32_t h;
+
+    for(h = 0; h < TLX49012_COMP_HARMONICS; h++)
+    {
+        uint16_t phase = (uint16_t)((h + 1) * angle);
+
+        sum += (int64_t)comp->cosine[h] * cosineQ15(phase) + (int64_t)comp->sine[h] * sineQ15(phase);
+    }
+
+    return (int32_t)(sum / 32768);
+}
+
+// Deviation of sample k from the ideal angle [1/16 LSB], slope in LSB per sample Q16
+static int32_t lineDeviation(int32_t unwrapped, uint32_t k, int64_t interceptQ4, int64_t slopeQ16)
+{
+    return (int32_t)(((int64_t)unwrapped * (1 << TLX49012_COMP_FRACTION_BITS)) - interceptQ4
+                     - ((slopeQ16 * k) >> (16 - TLX49012_COMP_FRACTION_BITS)));
+}
+
+void TLx49012_CompensationInit(TLx49012_Compensation *comp)
+{
+    uint32_t i;
+
+    comp->count = 0;
+    comp->residual = 0;
+    comp->fitted = false;
+
+    for(i = 0; i < TLX49012_COMP_HARMONICS; i++)
+    {
+        comp->cosine[i] = 0;
+        comp->sine[i] = 0;
+    }
+
+    for(i = 0; i <= TLX49012_COMP_TABLE_SIZE; i++)
+    {
+        comp->table[i] = 0;
+    }
+}
+
+bool TLx49012_CompensationCollect(TLx49012_Compensation *comp, uint16_t angleRaw)
+{
+    if(comp->count < TLX49012_COMP_SAMPLES)
+    {
+        comp->samples[comp->count++] = angleRaw;
+    }
+
+    return (comp->count >= TLX49012_COMP_SAMPLES);
+}
+
+bool TLx49012_CompensationFit(TLx49012_Compensation *comp)
+{
+    int64_t sumCos[TLX49012_COMP_HARMONICS] = {0};
+    int64_t sumSin[TLX49012_COMP_HARMONICS] = {0};
+    int64_t sumIntercept = 0;
+    int64_t interceptQ4;
+    int64_t slopeQ16;
+    int64_t timeQ16;
+    int32_t travel = 0;
+    int32_t target;
+    int32_t unwrapped;
+    int32_t previous = 0;
+    int32_t residual = 0;
+    uint32_t revolutions;
+    uint32_t used;
+    uint32_t k;
+    uint32_t h;
+
+    if(comp->count < TLX49012_COMP_SAMPLES)
+    {
+        return false;
+    }
+
+    /* Unwrapped travel over all samples, the angle moves less than half a revolution per sample */
+    for(k = 1; k < TLX49012_COMP_SAMPLES; k++)
+    {
+        travel += (int16_t)(comp->samples[k] - comp->samples[k - 1]);
+    }
+
+    /* Whole revolutions only, so that every harmonic is sampled over full periods */
+    revolutions = (uint32_t)((travel < 0) ? -travel : travel) / COMP_REVOLUTION;
+    if(revolutions == 0)
+    {
+        return false;
+    }
+    target = (int32_t)(revolutions * COMP_REVOLUTION);
+    if(travel < 0)
+    {
+        target = -target;
+    }
+
+    /* Time of the last whole revolution. The measured angle is back at the first sample there, and so is its error:
+     * the slope taken from it is free of the error, which a least-squares line over few revolutions is not.
+     */
+    unwrapped = 0;
+    for(k = 1; k < TLX49012_COMP_SAMPLES; k++)
+    {
+        previous = unwrapped;
+        unwrapped += (int16_t)(comp->samples[k] - comp->samples[k - 1]);
+
+        if((travel > 0) ? (unwrapped >= target) : (unwrapped <= target))
+        {
+            break;
+        }
+    }
+
+    timeQ16 = ((int64_t)(k - 1) << 16) + (((int64_t)(target - previous) * 65536) / (unwrapped - previous));
+    slopeQ16 = ((int64_t)target * 65536 * 65536) / timeQ16;
+    used = (uint32_t)(timeQ16 >> 16) + 1;
+
+    /* Offset of the ideal angle, the harmonics average out over the whole revolutions */
+    unwrapped = 0;
+    for(k = 0; k < used; k++)
+    {
+        if(k > 0)
+        {
+            unwrapped += (int16_t)(comp->samples[k] - comp->samples[k - 1]);
+        }
+
+        sumIntercept += lineDeviation(unwrapped, k, 0, slopeQ16);
+    }
+    interceptQ4 = sumIntercept / (int64_t)used;
+
+    /* DFT of the deviation from the ideal angle, over the measured angle */
+    unwrapped = 0;
+    for(k = 0; k < used; k++)
+    {
+        int32_t error;
+
+        if(k > 0)
+        {
+            unwrapped += (int16_t)(comp->samples[k] - comp->samples[k - 1]);
+        }
+
+        error = lineDeviation(unwrapped, k, interceptQ4, slopeQ16);
+
+        for(h = 0; h < TLX49012_COMP_HARMONICS; h++)
+        {
+            uint16_t phase = (uint16_t)((h + 1) * comp->samples[k]);
+
+            sumCos[h] += (int64_t)error * cosineQ15(phase);
+            sumSin[h] += (int64_t)error * sineQ15(phase);
+        }
+    }
+
+    for(h = 0; h < TLX49012_COMP_HARMONICS; h++)
+    {
+        comp->cosine[h] = (int32_t)((2 * sumCos[h]) / ((int64_t)used * 32768));
+        comp->sine[h] = (int32_t)((2 * sumSin[h]) / ((int64_t)used * 32768));
+    }
+
+    /* Largest error left, shows a speed that was not constant */
+    unwrapped = 0;
+    for(k = 0; k < used; k++)
+    {
+        int32_t error;
+
+        if(k > 0)
+        {
+            unwrapped += (int16_t)(comp->samples[k] - comp->samples[k - 1]);
+        }
+
+        error = lineDeviation(unwrapped, k, interceptQ4, slopeQ16) - harmonicError(comp, comp->samples[k]);
+
+        if(error < 0)
+        {
+            error = -error;
+        }
+        if(error > residual)
+        {
+            residual = error;
+        }
+    }
+    comp->residual = residual;
+
+    /* Correction table, one entry past the end for the interpolation */
+    for(k = 0; k <= TLX49012_COMP_TABLE_SIZE; k++)
+    {
+        int32_t error = harmonicError(comp, (uint16_t)(k << COMP_TABLE_SHIFT));
+
+        if(error > INT16_MAX)
+        {
+            error = INT16_MAX;
+        }
+        else if(error < INT16_MIN)
+        {
+            error = INT16_MIN;
+        }
+
+        comp->table[k] = (int16_t)error;
+    }
+
+    comp->fitted = true;
+
+    return true;
+}
+
+uint16_t TLx49012_CompensationApply(const TLx49012_Compensation *comp, uint16_t angleRaw)
+{
+    uint32_t index = (uint32_t)angleRaw >> COMP_TABLE_SHIFT;
+    int32_t fraction = (int32_t)(angleRaw & ((1U << COMP_TABLE_SHIFT) - 1U));
+    int32_t lower = comp->table[index];
+    int32_t error = lower + (((comp->table[index + 1] - lower) * fraction) >> COMP_TABLE_SHIFT);
+
+    /* Rounded to whole LSB */
+    return (uint16_t)(angleRaw - ((error + (1 << (TLX49012_COMP_FRACTION_BITS - 1))) >> TLX49012_COMP_FRACTION_BITS));
+}
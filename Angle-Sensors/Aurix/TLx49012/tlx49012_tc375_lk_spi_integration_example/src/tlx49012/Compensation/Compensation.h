@@ -0,0 +1,129 @@
+/**********************************************************************************************************************
+ * \file Compensation.h
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+#ifndef SRC_TLX49012_COMPENSATION_COMPENSATION_H_
+#define SRC_TLX49012_COMPENSATION_COMPENSATION_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+// Samples of one fit, taken at a fixed period while the magnet turns at constant speed. They have to cover at least
+// one revolution: 1024 samples every 500 us need 120 rpm or more.
+#ifndef TLX49012_COMP_SAMPLES
+#define TLX49012_COMP_SAMPLES           1024
+#endif
+
+// Error harmonics fitted, 1st to nth per revolution
+#ifndef TLX49012_COMP_HARMONICS
+#define TLX49012_COMP_HARMONICS         4
+#endif
+
+// Correction table over one revolution, 2^n entries, linearly interpolated
+#define TLX49012_COMP_TABLE_BITS        8
+#define TLX49012_COMP_TABLE_SIZE        (1U << TLX49012_COMP_TABLE_BITS)
+
+// Errors are kept in 1/16 LSB
+#define TLX49012_COMP_FRACTION_BITS     4
+
+#if (TLX49012_COMP_SAMPLES < 16) || (TLX49012_COMP_SAMPLES > 2048)
+#error "TLX49012_COMP_SAMPLES must be between 16 and 2048, the fit is sized for 64-bit sums"
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Harmonic angle-error compensation. The error of the measured angle against a constant-speed rotation is fitted
+ * with its first harmonics per revolution, and subtracted through a table over the measured angle. Fixed point only.
+ */
+typedef struct
+{
+    uint16_t samples[TLX49012_COMP_SAMPLES];                                /* Collected angles [LSB16]             */
+    uint32_t count;                                                         /* Samples collected so far             */
+    int32_t cosine[TLX49012_COMP_HARMONICS];                                /* Error harmonics, cos and sin parts   */
+    int32_t sine[TLX49012_COMP_HARMONICS];                                  /* [1/16 LSB]                           */
+    int32_t residual;                                                       /* Largest error left by the fit        */
+    int16_t table[TLX49012_COMP_TABLE_SIZE + 1];                            /* Error over the angle [1/16 LSB],     */
+                                                                            /* last entry repeats the first         */
+    bool fitted;
+} TLx49012_Compensation;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+/*******************************************************************************
+ * Function Name: TLx49012_CompensationInit
+ ***************************************************************************//**
+ * \brief   Clears the samples and the correction, TLx49012_CompensationApply
+ *          then returns the angle unchanged.
+ ******************************************************************************/
+void TLx49012_CompensationInit(TLx49012_Compensation *comp);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_CompensationCollect
+ ***************************************************************************//**
+ * \brief   Stores one angle for the fit. Call it at a fixed period while the
+ *          magnet turns at constant speed, without gaps.
+ * \param   angleRaw  Measured angle [LSB16].
+ * \return  true once TLX49012_COMP_SAMPLES angles are stored.
+ ******************************************************************************/
+bool TLx49012_CompensationCollect(TLx49012_Compensation *comp, uint16_t angleRaw);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_CompensationFit
+ ***************************************************************************//**
+ * \brief   Fits the error harmonics to the collected angles and builds the
+ *          correction table. The ideal angle runs at the speed of the last
+ *          whole revolution, where the measured angle and its error come
+ *          back to those of the first sample. The harmonics come from a Q15
+ *          DFT of the difference over the whole revolutions. Runs once, not
+ *          in the hot path.
+ * \return  false if the samples cover less than one revolution, the
+ *          correction is then left unchanged.
+ ******************************************************************************/
+bool TLx49012_CompensationFit(TLx49012_Compensation *comp);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_CompensationApply
+ ***************************************************************************//**
+ * \brief   Corrects a measured angle with the interpolated table. No loops,
+ *          integer only.
+ * \param   angleRaw  Measured angle [LSB16].
+ * \return  Corrected angle [LSB16].
+ ******************************************************************************/
+uint16_t TLx49012_CompensationApply(const TLx49012_Compensation *comp, uint16_t angleRaw);
+
+
+#endif /* SRC_TLX49012_COMPENSATION_COMPENSATION_H_ */
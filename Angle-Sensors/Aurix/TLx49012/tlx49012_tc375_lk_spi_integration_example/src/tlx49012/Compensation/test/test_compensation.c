@@ -0,0 +1,200 @@
+/**********************************************************************************************************************
+ * \file test_compensation.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+/* Host (Linux) test of the angle-error compensation, see the Makefile in this folder. Not part of the AURIX build.
+ * Synthetic constant-speed rotations carry a known error of 1st to 3rd harmonics, about 170 LSB at most, plus noise.
+ * Each is collected and fitted, then the fitted harmonics are compared with the known ones and every angle of the
+ * revolution is corrected and compared with the true angle. Both directions, a few to several hundred revolutions,
+ * and a rotation of less than one revolution, which the fit has to refuse.
+ */
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "Compensation.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_PI                 3.14159265358979323846
+
+/* Largest error after the correction and largest deviation of a fitted harmonic [LSB]. The fit is over the measured
+ * angle, the synthetic error over the true one: with 170 LSB of error both differ by about 1.6 LSB, noise-free too.
+ */
+#define TEST_CORRECTED_MAX      3.0
+#define TEST_HARMONIC_MAX       2.0
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* One synthetic rotation */
+typedef struct
+{
+    const char *name;
+    double turnsPerSample;                                                  /* Speed [revolutions per sample]       */
+    double noise;                                                           /* Peak-to-peak noise [LSB]             */
+    bool fits;                                                              /* Covers at least one revolution       */
+} Test_Rotation;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* Error harmonics of the synthetic sensor [LSB], the 4th is zero */
+static const double g_errorCosine[TLX49012_COMP_HARMONICS] = { 120.0, 40.0 * 0.95533648912560598, 0.0 };
+static const double g_errorSine[TLX49012_COMP_HARMONICS]   = { -80.0, -40.0 * 0.29552020666133955, 10.0 };
+
+static const Test_Rotation g_rotations[] =
+{
+    { "3.3 revolutions",                3.3 / TLX49012_COMP_SAMPLES,   4.0, true  },
+    { "1.7 revolutions, backwards",    -1.7 / TLX49012_COMP_SAMPLES,   4.0, true  },
+    { "1.1 revolutions",                1.1 / TLX49012_COMP_SAMPLES,   0.0, true  },
+    { "40 revolutions",                40.0 / TLX49012_COMP_SAMPLES,   2.0, true  },
+    { "0.37 revolutions per sample",    0.37,                          2.0, true  },
+    { "0.41 revolutions per sample, backwards", -0.41,                 2.0, true  },
+    { "0.8 revolutions",                0.8 / TLX49012_COMP_SAMPLES,   0.0, false },
+};
+
+static TLx49012_Compensation g_comp;
+static uint32_t g_failures;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void check(bool passed, const char *rotation, const char *what)
+{
+    if(!passed)
+    {
+        g_failures++;
+        printf("FAIL: %s: %s\n", rotation, what);
+    }
+}
+
+
+/* Error of the synthetic sensor at the true angle [LSB] */
+static double sensorError(double angle)
+{
+    double error = 0.0;
+
+    for(uint32_t h = 0; h < TLX49012_COMP_HARMONICS; h++)
+    {
+        error += (g_errorCosine[h] * cos((h + 1) * angle)) + (g_errorSine[h] * sin((h + 1) * angle));
+    }
+
+    return error;
+}
+
+
+/* Measured angle [LSB16] at the true angle [rad], rounded and wrapped like the sensor output */
+static uint16_t sensorAngle(double angle, double noise)
+{
+    double measured = (angle * 65536.0 / (2.0 * TEST_PI)) + sensorError(angle);
+
+    measured += noise * ((rand() / (double)RAND_MAX) - 0.5);
+
+    return (uint16_t)(int64_t)floor(measured + 0.5);
+}
+
+
+static void testRotation(const Test_Rotation *rotation)
+{
+    double start = 1.234;
+    double harmonicMax = 0.0;
+    double measuredMax = 0.0;
+    double correctedMax = 0.0;
+    bool complete = false;
+    uint32_t k;
+
+    srand(1);
+    TLx49012_CompensationInit(&g_comp);
+
+    for(k = 0; k < TLX49012_COMP_SAMPLES; k++)
+    {
+        complete = TLx49012_CompensationCollect(&g_comp, sensorAngle(start + (2.0 * TEST_PI * rotation->turnsPerSample * k),
+                                                                     rotation->noise));
+        check(complete == (k == (TLX49012_COMP_SAMPLES - 1)), rotation->name, "collection complete too early or late");
+    }
+
+    if(!TLx49012_CompensationFit(&g_comp))
+    {
+        check(!rotation->fits, rotation->name, "fit refused");
+
+        /* Refused - the angle passes unchanged */
+        for(uint32_t angle = 0; angle < 65536; angle += 97)
+        {
+            check(TLx49012_CompensationApply(&g_comp, (uint16_t)angle) == angle, rotation->name, "unfitted angle changed");
+        }
+        printf("%-40s fit refused\n", rotation->name);
+        return;
+    }
+    check(rotation->fits, rotation->name, "fit of less than one revolution");
+
+    for(uint32_t h = 0; h < TLX49012_COMP_HARMONICS; h++)
+    {
+        double cosine = g_comp.cosine[h] / (double)(1 << TLX49012_COMP_FRACTION_BITS);
+        double sine = g_comp.sine[h] / (double)(1 << TLX49012_COMP_FRACTION_BITS);
+
+        harmonicMax = fmax(harmonicMax, fmax(fabs(cosine - g_errorCosine[h]), fabs(sine - g_errorSine[h])));
+    }
+    check(harmonicMax <= TEST_HARMONIC_MAX, rotation->name, "fitted harmonics off");
+
+    /* Every angle of the revolution, across the wrap at 0 */
+    for(uint32_t angle = 0; angle < 65536; angle++)
+    {
+        uint16_t measured = sensorAngle(angle * 2.0 * TEST_PI / 65536.0, 0.0);
+        uint16_t corrected = TLx49012_CompensationApply(&g_comp, measured);
+
+        measuredMax = fmax(measuredMax, fabs((double)(int16_t)(measured - angle)));
+        correctedMax = fmax(correctedMax, fabs((double)(int16_t)(corrected - angle)));
+    }
+    check(correctedMax <= TEST_CORRECTED_MAX, rotation->name, "corrected angle off");
+
+    printf("%-40s error %3.0f LSB, corrected %1.0f LSB, harmonics within %.2f LSB, fit residual %.1f LSB\n",
+           rotation->name, measuredMax, correctedMax, harmonicMax,
+           g_comp.residual / (double)(1 << TLX49012_COMP_FRACTION_BITS));
+}
+
+
+int main(void)
+{
+    for(uint32_t i = 0; i < (sizeof(g_rotations) / sizeof(g_rotations[0])); i++)
+    {
+        testRotation(&g_rotations[i]);
+    }
+
+    printf("%s: %u failures\n", g_failures ? "FAIL" : "PASS", g_failures);
+
+    return g_failures ? 1 : 0;
+}
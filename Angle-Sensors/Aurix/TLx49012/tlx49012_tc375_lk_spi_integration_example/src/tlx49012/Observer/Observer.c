@@ -0,0 +1,107 @@
+/**********************************************************************************************************************
+ * \file Observer.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include "Observer.h"
+
+#include <math.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+#define OBSERVER_HALF_REVOLUTION    (OBSERVER_REVOLUTION / 2.0f)
+#define OBSERVER_LSB_TO_DEGREES     (360.0f / OBSERVER_REVOLUTION)
+#define OBSERVER_TWO_PI             6.28318531f
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+void TLx49012_ObserverInit(TLx49012_Observer *observer, float sampleTime, float bandwidth, uint16_t angleRaw)
+{
+    /* Discrete pole of the bandwidth, placed three times */
+    float pole = expf(-OBSERVER_TWO_PI * bandwidth * sampleTime);
+    float open = 1.0f - pole;
+
+    /* Error dynamics (I - L*H)*F with F the constant acceleration model: characteristic polynomial
+     * (z - 1)^3 + l1 (z - 1)^2 + l2 T z (z - 1) + l3 T^2 / 2 z (z + 1), matched to (z - pole)^3
+     */
+    observer->sampleTime = sampleTime;
+    observer->gainAngle = 1.0f - pole * pole * pole;
+    observer->gainSpeed = 1.5f * open * open * (1.0f + pole) / sampleTime;
+    observer->gainAcceleration = open * open * open / (sampleTime * sampleTime);
+
+    observer->angle = (float)angleRaw;
+    observer->speed = 0.0f;
+    observer->acceleration = 0.0f;
+}
+
+void TLx49012_ObserverUpdate(TLx49012_Observer *observer, uint16_t angleRaw, bool valid,
+                             TLx49012_ObserverOutput *output)
+{
+    float T = observer->sampleTime;
+    float angle;
+    float speed;
+    float error;
+
+    /* Prediction, constant acceleration over one period */
+    angle = observer->angle + T * (observer->speed + 0.5f * T * observer->acceleration);
+    speed = observer->speed + T * observer->acceleration;
+
+    /* Tracking error on the shortest way round, the angle moves less than half a revolution per period */
+    error = valid ? ((float)angleRaw - angle) : 0.0f;
+    if(error >= OBSERVER_HALF_REVOLUTION)
+    {
+        error -= OBSERVER_REVOLUTION;
+    }
+    else if(error < -OBSERVER_HALF_REVOLUTION)
+    {
+        error += OBSERVER_REVOLUTION;
+    }
+
+    /* Correction */
+    angle += observer->gainAngle * error;
+    observer->speed = speed + observer->gainSpeed * error;
+    observer->acceleration += observer->gainAcceleration * error;
+
+    /* Back to one revolution */
+    if(angle >= OBSERVER_REVOLUTION)
+    {
+        angle -= OBSERVER_REVOLUTION;
+    }
+    else if(angle < 0.0f)
+    {
+        angle += OBSERVER_REVOLUTION;
+    }
+    observer->angle = angle;
+
+    output->angle = angle * OBSERVER_LSB_TO_DEGREES;
+    output->speed = observer->speed * OBSERVER_LSB_TO_DEGREES;
+    output->acceleration = observer->acceleration * OBSERVER_LSB_TO_DEGREES;
+}
@@ -0,0 +1,101 @@
+/**********************************************************************************************************************
+ * \file Observer.h
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+#ifndef SRC_TLX49012_OBSERVER_OBSERVER_H_
+#define SRC_TLX49012_OBSERVER_OBSERVER_H_
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+// One revolution in LSB16
+#define OBSERVER_REVOLUTION         65536.0f
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+/* Angle tracking observer, third order: angle, speed and acceleration states, all three closed-loop poles at the
+ * bandwidth. Tracks a constant acceleration without steady-state error. Single precision only, the TC3xx FPU has
+ * no double. Angles are kept in LSB16 so that the tracking error wraps like the sensor angle.
+ */
+typedef struct
+{
+    float sampleTime;                                                       /* Update period [s]                    */
+    float gainAngle;                                                        /* Correction gains                     */
+    float gainSpeed;
+    float gainAcceleration;
+    float angle;                                                            /* Estimate [LSB16], 0 to 65536         */
+    float speed;                                                            /* Estimate [LSB16/s]                   */
+    float acceleration;                                                     /* Estimate [LSB16/s^2]                 */
+} TLx49012_Observer;
+
+/* Observer output of one update */
+typedef struct
+{
+    float angle;                                                            /* Angle [deg], 0 to 360                */
+    float speed;                                                            /* Speed [deg/s]                        */
+    float acceleration;                                                     /* Acceleration [deg/s^2]               */
+} TLx49012_ObserverOutput;
+
+/*********************************************************************************************************************/
+/*------------------------------------------------Function Prototypes------------------------------------------------*/
+/*********************************************************************************************************************/
+/*******************************************************************************
+ * Function Name: TLx49012_ObserverInit
+ ***************************************************************************//**
+ * \brief   Sets the observer up for a fixed update period and starts it at
+ *          rest at a measured angle.
+ * \param   observer    Observer to set up.
+ * \param   sampleTime  Update period [s].
+ * \param   bandwidth   Closed-loop bandwidth [Hz], well below 1 / sampleTime.
+ *                      Higher follows faster, lower filters more noise.
+ * \param   angleRaw    First measured angle [LSB16].
+ ******************************************************************************/
+void TLx49012_ObserverInit(TLx49012_Observer *observer, float sampleTime, float bandwidth, uint16_t angleRaw);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_ObserverUpdate
+ ***************************************************************************//**
+ * \brief   Advances the observer by one period and corrects it with the
+ *          measured angle. Without a valid measurement it only predicts.
+ *          No loops and no library calls, so the cycle count is fixed.
+ * \param   observer    Observer, one update per sampleTime.
+ * \param   angleRaw    Measured angle [LSB16].
+ * \param   valid       false if the measurement failed its check.
+ * \param   output      Angle, speed and acceleration after the update.
+ ******************************************************************************/
+void TLx49012_ObserverUpdate(TLx49012_Observer *observer, uint16_t angleRaw, bool valid,
+                             TLx49012_ObserverOutput *output);
+
+
+#endif /* SRC_TLX49012_OBSERVER_OBSERVER_H_ */
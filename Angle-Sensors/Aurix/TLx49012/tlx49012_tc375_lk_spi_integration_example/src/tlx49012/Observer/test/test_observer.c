@@ -0,0 +1,214 @@
+/**********************************************************************************************************************
+ * \file test_observer.c
+ * \copyright Copyright (C) Infineon Technologies AG 2019
+ * 
+ * Use of this file is subject to the terms of use agreed between (i) you or the company in which ordinary course of 
+ * business you are acting and (ii) Infineon Technologies AG or its licensees. If and as long as no such terms of use
+ * are agreed, use of this file is subject to following:
+ * 
+ * Boost Software License - Version 1.0 - August 17th, 2003
+ * 
+ * Permission is hereby granted, free of charge, to any person or organization obtaining a copy of the software and 
+ * accompanying documentation covered by this license (the "Software") to use, reproduce, display, distribute, execute,
+ * and transmit the Software, and to prepare derivative works of the Software, and to permit third-parties to whom the
+ * Software is furnished to do so, all subject to the following:
+ * 
+ * The copyright notices in the Software and this entire statement, including the above license grant, this restriction
+ * and the following disclaimer, must be included in all copies of the Software, in whole or in part, and all 
+ * derivative works of the Software, unless such copies or derivative works are solely in the form of 
+ * machine-executable object code generated by a source language processor.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ * WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE, TITLE AND NON-INFRINGEMENT. IN NO EVENT SHALL THE 
+ * COPYRIGHT HOLDERS OR ANYONE DISTRIBUTING THE SOFTWARE BE LIABLE FOR ANY DAMAGES OR OTHER LIABILITY, WHETHER IN 
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS 
+ * IN THE SOFTWARE.
+ *********************************************************************************************************************/
+
+/* Host (Linux) test of the angle tracking observer, see the Makefile in this folder. Not part of the AURIX build.
+ * Synthetic trajectories are sampled like the sensor: the true angle rounded to LSB16 and wrapped at 360 degrees.
+ * Constant speed in both directions, constant acceleration, an oscillation across 0/360 degrees and dropped samples,
+ * single ones and a burst, for which the observer only predicts. Each runs at the 2 kHz / 50 Hz of the example and at
+ * 20 kHz / 200 Hz of a motor loop. Once settled, the angle and speed estimates must stay within fixed bounds of the
+ * true ones and the angle within 0 to 360 degrees throughout.
+ */
+
+/*********************************************************************************************************************/
+/*-----------------------------------------------------Includes------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#include "Observer.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TEST_PI                 3.14159265358979323846
+
+/* Run length and settling time in time constants of the bandwidth, 1 / (2 pi bandwidth) */
+#define TEST_RUN_TAU            400.0
+#define TEST_SETTLE_TAU         40.0
+
+/* Dropped samples: one in TEST_DROP_EVERY, and TEST_DROP_BURST in a row halfway through the run */
+#define TEST_DROP_EVERY         10
+#define TEST_DROP_BURST         20
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+/* One synthetic trajectory, true angle [deg] and speed [deg/s] over time [s] */
+typedef struct
+{
+    const char *name;
+    double (*angle)(double t);
+    double (*speed)(double t);
+    bool drops;                                                             /* Single drops and a burst             */
+} Test_Trajectory;
+
+/* Update rate and bandwidth, with the bounds after settling */
+typedef struct
+{
+    const char *name;
+    double sampleTime;                                                      /* [s]                                  */
+    double bandwidth;                                                       /* [Hz]                                 */
+    double angleMax;                                                        /* Largest angle error [deg]            */
+    double speedMax;                                                        /* Largest speed error [deg/s]          */
+} Test_Rate;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+static double constantSpeed(double t)           { return 10.0 + (18000.0 * t); }              /* 3000 rpm        */
+static double constantSpeedRate(double t)       { (void)t; return 18000.0; }
+static double reverseSpeed(double t)            { return 350.0 - (18000.0 * t); }
+static double reverseSpeedRate(double t)        { (void)t; return -18000.0; }
+static double acceleration(double t)            { return 10.0 + (100.0 * t) + (0.5 * 50000.0 * t * t); }
+static double accelerationRate(double t)        { return 100.0 + (50000.0 * t); }
+static double acrossZero(double t)              { return 20.0 * sin(2.0 * TEST_PI * t); }  /* +-20 deg, 1 Hz  */
+static double acrossZeroRate(double t)          { return 20.0 * 2.0 * TEST_PI * cos(2.0 * TEST_PI * t); }
+
+static const Test_Trajectory g_trajectories[] =
+{
+    { "constant speed",                     constantSpeed,  constantSpeedRate,  false },
+    { "constant speed, backwards",          reverseSpeed,   reverseSpeedRate,   false },
+    { "constant acceleration",              acceleration,   accelerationRate,   false },
+    { "across 0/360 degrees",               acrossZero,     acrossZeroRate,     false },
+    { "constant speed, dropped samples",    constantSpeed,  constantSpeedRate,  true  },
+    { "acceleration, dropped samples",      acceleration,   accelerationRate,   true  },
+};
+
+/* The rounding of the angle to 0.0055 degrees sets the floor of both errors, the speed error grows with the rate */
+static const Test_Rate g_rates[] =
+{
+    { "2 kHz, 50 Hz",       500e-6,     50.0,   0.005,  1.5 },
+    { "20 kHz, 200 Hz",     50e-6,      200.0,  0.005,  6.0 },
+};
+
+static uint32_t g_failures;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+static void check(bool passed, const char *trajectory, const char *rate, const char *what)
+{
+    if(!passed)
+    {
+        g_failures++;
+        printf("FAIL: %s at %s: %s\n", trajectory, rate, what);
+    }
+}
+
+
+/* Measured angle [LSB16] at the true angle [deg], rounded and wrapped like the sensor output */
+static uint16_t sensorAngle(double angle)
+{
+    return (uint16_t)(int64_t)floor((angle * 65536.0 / 360.0) + 0.5);
+}
+
+
+/* Angle difference on the shortest way round [deg] */
+static double angleError(double estimate, double angle)
+{
+    double error = fmod(estimate - angle, 360.0);
+
+    if(error >= 180.0)
+    {
+        error -= 360.0;
+    }
+    else if(error < -180.0)
+    {
+        error += 360.0;
+    }
+
+    return fabs(error);
+}
+
+
+static bool dropped(const Test_Trajectory *trajectory, uint32_t k, uint32_t samples)
+{
+    if(!trajectory->drops)
+    {
+        return false;
+    }
+
+    return ((k % TEST_DROP_EVERY) == 0) || ((k >= (samples / 2)) && (k < ((samples / 2) + TEST_DROP_BURST)));
+}
+
+
+static void testTrajectory(const Test_Trajectory *trajectory, const Test_Rate *rate)
+{
+    double tau = 1.0 / (2.0 * TEST_PI * rate->bandwidth);
+    uint32_t samples = (uint32_t)(TEST_RUN_TAU * tau / rate->sampleTime);
+    uint32_t settle = (uint32_t)(TEST_SETTLE_TAU * tau / rate->sampleTime);
+    double angleMax = 0.0;
+    double speedMax = 0.0;
+    bool inRange = true;
+    TLx49012_Observer observer;
+    TLx49012_ObserverOutput output;
+
+    TLx49012_ObserverInit(&observer, (float)rate->sampleTime, (float)rate->bandwidth, sensorAngle(trajectory->angle(0.0)));
+
+    for(uint32_t k = 1; k <= samples; k++)
+    {
+        double t = k * rate->sampleTime;
+
+        TLx49012_ObserverUpdate(&observer, sensorAngle(trajectory->angle(t)), !dropped(trajectory, k, samples), &output);
+
+        inRange = inRange && (output.angle >= 0.0f) && (output.angle <= 360.0f);
+
+        if(k > settle)
+        {
+            angleMax = fmax(angleMax, angleError(output.angle, trajectory->angle(t)));
+            speedMax = fmax(speedMax, fabs(output.speed - trajectory->speed(t)));
+        }
+    }
+
+    check(inRange, trajectory->name, rate->name, "angle outside of 0 to 360 degrees");
+    check(angleMax <= rate->angleMax, trajectory->name, rate->name, "angle off");
+    check(speedMax <= rate->speedMax, trajectory->name, rate->name, "speed off");
+
+    printf("%-36s %-16s angle within %.4f deg, speed within %.3f deg/s\n", trajectory->name, rate->name, angleMax,
+           speedMax);
+}
+
+
+int main(void)
+{
+    for(uint32_t r = 0; r < (sizeof(g_rates) / sizeof(g_rates[0])); r++)
+    {
+        for(uint32_t i = 0; i < (sizeof(g_trajectories) / sizeof(g_trajectories[0])); i++)
+        {
+            testTrajectory(&g_trajectories[i], &g_rates[r]);
+        }
+    }
+
+    printf("%s: %u failures\n", g_failures ? "FAIL" : "PASS", g_failures);
+
+    return g_failures ? 1 : 0;
+}
@@ -34,6 +34,7 @@
 #include "IfxPort.h"
 #include "time.h"
 #include "spi.h"
+#include "xensiv_nextframe.h"
 
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
@@ -51,9 +52,13 @@ const uint16 OTP_254_CONTENT_OK   = 0x6088;
 const uint16 OTP_255_CONTENT_OK   = 0x0317;
 const uint16 OTP_DUMMY_CONTENT_OK = 0xF16B;
 
+// Response check counters of SpiSendAndReceiveChecked()
+static T_SpiFrameErrors g_spi_frame_errors;
+
 /*********************************************************************************************************************/
 /*------------------------------------------------Function Prototypes------------------------------------------------*/
 /*********************************************************************************************************************/
+static xensiv_rsp_frame_t SpiTransferNextFrame(const uint8_t frame[4], void *context);
 
 /*********************************************************************************************************************/
 /*---------------------------------------------Function Implementations----------------------------------------------*/
@@ -102,6 +107,68 @@ uint32 SpiReadInFrame(uint8 addr, uint8 clearStatus)
     return SpiSendAndReceive(data_temp);
 }
 
+xensiv_rsp_frame_t SpiReadInFrameChecked(uint8 addr, uint8 clearStatus)
+{
+    static uint8 data_temp[4]     = {0,0,0,0};
+
+    /* Same frame as SpiReadInFrame() */
+    data_temp[0] = (addr << 1);                 // 7bit address 1 bit R/W = 0
+    data_temp[1] = 0x00;                        // Unused
+    data_temp[2] = clearStatus ? 0xFF : 0x00;   // All 1s clear device status bit
+    data_temp[3] = CalcCRC(data_temp, 3);       // 1 byte CRC
+
+    // Send the data through the SPI channel, response checked on arrival
+    return SpiSendAndReceiveChecked(data_temp);
+}
+
+uint32 SpiCommandNextFrame(uint16 addr, uint8 accessType)
+{
+    static uint8 data_temp[4]     = {0,0,0,0};
+
+    /* 14bit address and 2bit register access type */
+    xensiv_nxf_command_frame(data_temp, addr, accessType);
+
+    // Send the data through the SPI channel, response depends on the previous frame
+    return SpiSendAndReceive(data_temp);
+}
+
+uint32 SpiReadNextFrame(uint8 clearStatus)
+{
+    static uint8 data_temp[4]     = {0,0,0,0};
+    const uint8 *read_frame       = XENSIV_NXF_READ_FRAME[clearStatus ? 1 : 0];
+
+    /* Constant read frame, CRC precomputed */
+    data_temp[0] = read_frame[0];
+    data_temp[1] = read_frame[1];
+    data_temp[2] = read_frame[2];
+    data_temp[3] = read_frame[3];
+
+    // Send the data through the SPI channel
+    return SpiSendAndReceive(data_temp);
+}
+
+uint32 SpiReadRegNextFrame(uint16 addr, uint8 clearStatus)
+{
+    SpiCommandNextFrame(addr, AC_READ_INC);
+    return SpiReadNextFrame(clearStatus);
+}
+
+uint16 SpiReadRegListNextFrame(const uint16 *addrList, uint16 count, uint8 clearStatus, uint16 *data)
+{
+    // The command of register N+1 travels in the frame that returns register N: count + 1 frames.
+    // Every response is checked and counted, one failing the check fails the list
+    return xensiv_nxf_read_list(addrList, count, clearStatus != 0, data, &SpiTransferNextFrame, NULL_PTR);
+}
+
+static xensiv_rsp_frame_t SpiTransferNextFrame(const uint8_t frame[4], void *context)
+{
+    uint8 data_temp[4] = {frame[0], frame[1], frame[2], frame[3]};
+
+    (void)context;
+
+    // Same CRC and status check as SpiReadInFrameChecked(), counted in SpiGetFrameErrors()
+    return SpiSendAndReceiveChecked(data_temp);
+}
 
 uint32 SpiSendAndReceive(uint8* data_temp)
 {
@@ -112,6 +179,29 @@ uint32 SpiSendAndReceive(uint8* data_temp)
     return SpiMasterSendAndReceive(send_data);
 }
 
+xensiv_rsp_frame_t SpiSendAndReceiveChecked(uint8* data_temp)
+{
+    // Decoded as soon as the transfer is complete - a frame failing the check never passes as data
+    xensiv_rsp_frame_t frame = xensiv_rsp_decode(SpiSendAndReceive(data_temp), SPI_STATUS_ERROR_MASK);
+
+    g_spi_frame_errors.frames++;
+    if(frame.error & XENSIV_RSP_ERROR_CRC)
+    {
+        g_spi_frame_errors.crcErrors++;
+    }
+    if(frame.error & XENSIV_RSP_ERROR_STATUS)
+    {
+        g_spi_frame_errors.statusErrors++;
+    }
+
+    return frame;
+}
+
+T_SpiFrameErrors SpiGetFrameErrors(void)
+{
+    return g_spi_frame_errors;
+}
+
 
 
 
@@ -34,6 +34,7 @@
 #include "CRC8_SAE_J1850.h"
 #include "IfxPort.h"
 #include "time.h"
+#include "xensiv_response.h"
 
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
@@ -77,6 +78,9 @@
 #define AC_WRITE_CONT   1
 #define AC_WRITE_INC    2
 
+// RESPONSE CHECK - device status bits counted as errors, see the datasheet of the variant
+#define SPI_STATUS_ERROR_MASK   0x00
+
 /*********************************************************************************************************************/
 /*-------------------------------------------------Global variables--------------------------------------------------*/
 /*********************************************************************************************************************/
@@ -90,6 +94,12 @@ typedef struct {
     uint8 otp_dummy;
 } T_ProgramStatusReturn;
 
+typedef struct {
+    uint32 frames;          // Responses checked
+    uint32 crcErrors;       // Responses failing the CRC check
+    uint32 statusErrors;    // Responses with a SPI_STATUS_ERROR_MASK status bit set
+} T_SpiFrameErrors;
+
 /*********************************************************************************************************************/
 /*--------------------------------------------Private Variables/Constants--------------------------------------------*/
 /*********************************************************************************************************************/
@@ -104,13 +114,17 @@ uint32 EnterTestMode(uint8 accessRights);
 void ExitTestMode();
 uint32 SpiWriteInFrame(uint8 addr, uint16 data);
 uint32 SpiReadInFrame(uint8 addr, uint8 clearStatus);
+xensiv_rsp_frame_t SpiReadInFrameChecked(uint8 addr, uint8 clearStatus);
 uint32 SpiCommandNextFrame(uint16 addr, uint8 accessType);
 uint32 SpiEndCommandNextFrame();
 uint32 SpiWriteNextFrame(uint16 data);
 uint32 SpiReadNextFrame(uint8 clearStatus);
 uint32 SpiReadRegNextFrame(uint16 addr, uint8 clearStatus);
 uint32 SpiWriteRegNextFrame(uint16 addr, uint16 data);
+uint16 SpiReadRegListNextFrame(const uint16 *addrList, uint16 count, uint8 clearStatus, uint16 *data);
 uint32 SpiSendAndReceive(uint8* data_temp);
+xensiv_rsp_frame_t SpiSendAndReceiveChecked(uint8* data_temp);
+T_SpiFrameErrors SpiGetFrameErrors(void);
 uint32 VM_SoftReset();
 uint32 NVM_SoftReset();
 uint32 VM_SoftResetTestMode(uint8 accessRights);
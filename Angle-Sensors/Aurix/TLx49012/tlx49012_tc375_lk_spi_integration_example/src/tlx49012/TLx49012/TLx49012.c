@@ -46,6 +46,8 @@
 /*********************************************************************************************************************/
 /*-------------------------------------------------Global variables--------------------------------------------------*/
 /*********************************************************************************************************************/
+/* User configuration area as read back after the reset, USR_CONFIG_FIRST_ADDR first - for OneEye */
+uint16 g_usrConfig[USR_CONFIG_COUNT];
 
 /*********************************************************************************************************************/
 /*--------------------------------------------Private Variables/Constants--------------------------------------------*/
@@ -68,9 +70,6 @@ void TLx49012_Init(void)
     len = sprintf(buf, "\n\n\n\nSensor initialization in progress...\r\n" );
     UART_send_buf(buf, (uint16)len);
 
-    // Populate CRC LUT
-    CRCInit();
-
     // Wait for SPI to become active - ASSUME JUST POWERED ON
     TIME_wait_us(550);
 
@@ -85,9 +84,9 @@ void TLx49012_Init(void)
     SpiWriteInFrame(STAT_EN_1_REG_ADDR, CRC_BM_DIS_DATA);
 
     // Test sensor responses
-    uint32_t dataTest;
-    dataTest = SpiReadInFrame(STAT_EN_1_REG_ADDR, true);
-    if(((dataTest & 0x00FFFF00) >> 8) != CRC_BM_DIS_DATA)
+    xensiv_rsp_frame_t dataTest;
+    dataTest = SpiReadInFrameChecked(STAT_EN_1_REG_ADDR, true);
+    if((dataTest.error != 0) || (dataTest.data != CRC_BM_DIS_DATA))
     {
         while(1)
         {
@@ -111,9 +110,18 @@ void TLx49012_Init(void)
     // Wait for SPI to become active
     TIME_wait_us(900);
 
-    // Configuration check after reset
-    dataTest = SpiReadInFrame(USR_CONFIG_1_ADDR, true);
-    if(((dataTest & 0x00FFFF00) >> 8) != USR_CONFIG_1_DATA)
+    // Configuration check after reset - the whole user configuration area as one register list, count + 1 frames.
+    // A response failing the check fails the list
+    uint16 usrConfigAddr[USR_CONFIG_COUNT];
+    uint16 i;
+
+    for(i = 0; i < USR_CONFIG_COUNT; i++)
+    {
+        usrConfigAddr[i] = USR_CONFIG_FIRST_ADDR + i;
+    }
+
+    if((SpiReadRegListNextFrame(usrConfigAddr, USR_CONFIG_COUNT, TRUE, g_usrConfig) == 0)
+       || (g_usrConfig[USR_CONFIG_1_ADDR - USR_CONFIG_FIRST_ADDR] != USR_CONFIG_1_DATA))
     {
         while(1)
         {
@@ -129,51 +137,251 @@ void TLx49012_Init(void)
     UART_send_buf(buf, (uint16)len);
 }
 
-uint16 TLx49012_GetAngleLSB( void )
+boolean TLx49012_GetAngleLSB( uint16 *angleLSB )
+{
+    xensiv_rsp_frame_t sensor_response;
+
+    /* Read out the ANGLE_PRED_ADDR register, response checked */
+    sensor_response = SpiReadInFrameChecked(ANGLE_PRED_ADDR, true);
+
+    if(sensor_response.error != 0)
+    {
+        return FALSE;
+    }
+
+    /* Only the data bits of a checked response */
+    *angleLSB = sensor_response.data;
+
+    return TRUE;
+}
+
+boolean TLx49012_GetAngleLSBCompensated( uint16 *angleLSB, const TLx49012_Compensation *comp )
 {
-    uint32 sensor_response;
+    uint16 angleRaw;
+
+    if(!TLx49012_GetAngleLSB(&angleRaw))
+    {
+        return FALSE;
+    }
 
-    /* Read out the ANGLE_PRED_ADDR register */
-    sensor_response = SpiReadInFrame(ANGLE_PRED_ADDR, true);
+    *angleLSB = TLx49012_CompensationApply(comp, angleRaw);
 
-    /* Return the sensor response truncated to only the data bits */
-    return (uint16)((sensor_response & 0x00FFFF00) >> 8);
+    return TRUE;
 }
 
+boolean TLx49012_CalibrateCompensation( TLx49012_Compensation *comp )
+{
+    char buf[200];
+    int len = 0;
+    uint16 angleRaw;
+    uint32 h;
+    uint32 period = TIME_ticks_us(500);
+    uint32 deadline = TIME_now();
+
+    len = sprintf(buf, "Angle-error compensation: turn the magnet at constant speed...\r\n");
+    UART_send_buf(buf, (uint16)len);
+
+    /* Gapless samples at the loop period, a failed read or a missed STM deadline breaks the constant speed */
+    TLx49012_CompensationInit(comp);
+    while(1)
+    {
+        deadline += period;
+        if(FALSE == TIME_wait_until(deadline))
+        {
+            deadline = TIME_now();
+            TLx49012_CompensationInit(comp);
+        }
+
+        if(!TLx49012_GetAngleLSB(&angleRaw))
+        {
+            TLx49012_CompensationInit(comp);
+        }
+        else if(TLx49012_CompensationCollect(comp, angleRaw))
+        {
+            break;
+        }
+    }
+
+    if(!TLx49012_CompensationFit(comp))
+    {
+        len = sprintf(buf, "ERROR: Less than one revolution, angle not compensated\r\n");
+        UART_send_buf(buf, (uint16)len);
+
+        return FALSE;
+    }
+
+    /* Harmonics in degrees */
+    for(h = 0; h < TLX49012_COMP_HARMONICS; h++)
+    {
+        len = sprintf(buf, "Harmonic %lu [deg]: cos %.4f, sin %.4f\r\n",
+                      (unsigned long)(h + 1),
+                      (comp->cosine[h] * 360.0f) / (65536 << TLX49012_COMP_FRACTION_BITS),
+                      (comp->sine[h] * 360.0f) / (65536 << TLX49012_COMP_FRACTION_BITS));
+        UART_send_buf(buf, (uint16)len);
+    }
+
+    len = sprintf(buf, "Angle-error compensation DONE! Largest error left %.4f deg\r\n",
+                  (comp->residual * 360.0f) / (65536 << TLX49012_COMP_FRACTION_BITS));
+    UART_send_buf(buf, (uint16)len);
+
+    return TRUE;
+}
 
-double TLx49012_GetAngleDegrees( void )
+boolean TLx49012_GetAngleDegrees( double *angleDegrees )
 {
-   /* Read the ANGLE_PRED_REG which is at address 12 (0x0C) */
-   uint32 data_Rx = SpiReadInFrame(ANGLE_PRED_ADDR, true);
+   TLx49012_Sample sample;
 
-   /* Split the Received data */
-   g_CRC_raw = data_Rx & 0xFF;
-   g_angle_raw = (data_Rx >> 8) & 0xFFFF;
-   g_status_raw = (data_Rx >> 24) & 0xFF;
+   /* Corrupted response - keep the last angle */
+   if(!TLx49012_GetSample(&sample))
+   {
+       return FALSE;
+   }
 
    /* Compute angle */
-   angle = (g_angle_raw * 360.0f) / 65536;
+   angle = (sample.angleRaw * 360.0f) / 65536;
 
    /* Return result */
-   return angle;
+   *angleDegrees = angle;
+
+   return TRUE;
+}
+
+boolean TLx49012_GetSample( TLx49012_Sample *sample )
+{
+    /* Read the ANGLE_PRED_REG which is at address 12 (0x0C), split and checked on arrival */
+    xensiv_rsp_frame_t data_Rx = SpiReadInFrameChecked(ANGLE_PRED_ADDR, true);
+
+    g_error_raw = data_Rx.error;
+
+    /* Corrupted response - keep the last valid frame */
+    if(data_Rx.error == 0)
+    {
+        g_CRC_raw = data_Rx.crc;
+        g_angle_raw = data_Rx.data;
+        g_status_raw = data_Rx.status;
+    }
+
+    sample->angleRaw = g_angle_raw;
+    sample->status = (uint8)g_status_raw;
+    sample->crc = (uint8)g_CRC_raw;
+    sample->error = g_error_raw;
+
+    return (data_Rx.error == 0) ? TRUE : FALSE;
+}
+
+void TLx49012_WindowInit( TLx49012_Window *window, uint32 length )
+{
+    uint8 bit;
+
+    window->length = length;
+    window->count = 0;
+    window->errors = 0;
+    window->crcErrors = 0;
+    window->reference = 0;
+    window->previous = 0;
+    window->position = 0;
+    window->minOffset = 0;
+    window->maxOffset = 0;
+    window->sumOffset = 0;
+
+    for(bit = 0; bit < 8; bit++)
+    {
+        window->statusBits[bit] = 0;
+    }
 }
 
-void TLx49012_PrintSerialData(void)
+boolean TLx49012_WindowAdd( TLx49012_Window *window, const TLx49012_Sample *sample )
+{
+    window->count++;
+
+    if(sample->error != 0)
+    {
+        window->errors++;
+        if(sample->error & XENSIV_RSP_ERROR_CRC)
+        {
+            window->crcErrors++;
+        }
+    }
+    else
+    {
+        uint32 valid = window->count - window->errors;
+        uint8 status = sample->status;
+        uint8 bit = 0;
+
+        /* Status bits of the frame, at most 8 steps */
+        while(status != 0)
+        {
+            if(status & 1)
+            {
+                window->statusBits[bit]++;
+            }
+            status >>= 1;
+            bit++;
+        }
+
+        /* Position from the first valid angle: the step since the last valid angle, wrap-around through the
+         * 16-bit difference, so the position keeps counting past 180 degrees and over whole turns
+         */
+        if(valid == 1)
+        {
+            window->reference = sample->angleRaw;
+            window->previous = sample->angleRaw;
+        }
+
+        window->position += (sint16)(uint16)(sample->angleRaw - window->previous);
+        window->previous = sample->angleRaw;
+
+        if((valid == 1) || (window->position < window->minOffset))
+        {
+            window->minOffset = window->position;
+        }
+        if((valid == 1) || (window->position > window->maxOffset))
+        {
+            window->maxOffset = window->position;
+        }
+        window->sumOffset += window->position;
+    }
+
+    return (window->count >= window->length) ? TRUE : FALSE;
+}
+
+void TLx49012_PrintWindow(const TLx49012_Window *window, uint32 dropped)
 {
     /* UART variables */
-    char buf[200];
+    char buf[256];
     int len = 0;
+    uint32 valid = window->count - window->errors;
+    uint16 meanRaw = window->reference;
 
-    /*Print global available data */
-    len = sprintf(buf, "\nNEW FRAME\n"
-                           "Device Status: 0x%02X\n"
-                           "Angle [LSB16]: 0x%04X\n"
-                           "CRC:           0x%02X\n"
-                           "Angle [deg]:   %.2f\n\n",
-                           g_status_raw,
-                           g_angle_raw,
-                           g_CRC_raw,
-                           angle
+    /* Mean back from the positions, truncated towards the reference, and taken modulo one turn */
+    if(valid > 0)
+    {
+        meanRaw = (uint16)(window->reference + (sint32)(window->sumOffset / (sint64)valid));
+    }
+
+    /*Print the window - angles of valid samples only */
+    len = sprintf(buf, "\nNEW WINDOW\n"
+                           "Samples:       %lu (dropped %lu)\n"
+                           "Errors:        %lu (CRC errors %lu, status errors %lu)\n"
+                           "Angle [deg]:   mean %.2f, min %.2f, max %.2f, span %.2f\n"
+                           "Status bits:   7:%lu 6:%lu 5:%lu 4:%lu 3:%lu 2:%lu 1:%lu 0:%lu\n\n",
+                           (unsigned long)window->count,
+                           (unsigned long)dropped,
+                           (unsigned long)window->errors,
+                           (unsigned long)window->crcErrors,
+                           (unsigned long)(window->errors - window->crcErrors),
+                           (meanRaw * 360.0f) / 65536,
+                           ((uint16)(window->reference + window->minOffset) * 360.0f) / 65536,
+                           ((uint16)(window->reference + window->maxOffset) * 360.0f) / 65536,
+                           ((window->maxOffset - window->minOffset) * 360.0f) / 65536,
+                           (unsigned long)window->statusBits[7],
+                           (unsigned long)window->statusBits[6],
+                           (unsigned long)window->statusBits[5],
+                           (unsigned long)window->statusBits[4],
+                           (unsigned long)window->statusBits[3],
+                           (unsigned long)window->statusBits[2],
+                           (unsigned long)window->statusBits[1],
+                           (unsigned long)window->statusBits[0]
                 );
 
 
@@ -181,4 +389,3 @@ void TLx49012_PrintSerialData(void)
     UART_send_buf(buf, (uint16)len);
 
 }
-
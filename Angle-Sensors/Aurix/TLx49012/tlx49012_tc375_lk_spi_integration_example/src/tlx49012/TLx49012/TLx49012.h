@@ -34,6 +34,7 @@
 #include "time.h"
 #include "SPI_Frontend.h"
 #include "CRC8_SAE_J1850.h"
+#include "Compensation.h"
 
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
@@ -51,6 +52,11 @@
 // SPI + SYNC ON IFE + FALLING EDGE SYNC (SPI CONFIG VALID ONLY FOR S0001 & E0001) - CHECK VARIANT
 #define USR_CONFIG_1_DATA           0x400
 
+// USER CONFIGURATION AREA - read back after reset as one next-frame register list
+#define USR_CONFIG_FIRST_ADDR       0x3F
+#define USR_CONFIG_LAST_ADDR        0x4D
+#define USR_CONFIG_COUNT            (USR_CONFIG_LAST_ADDR - USR_CONFIG_FIRST_ADDR + 1)
+
 // PREDICTED ANGLE REGISTER
 #define ANGLE_PRED_ADDR             0x0C
 
@@ -68,6 +74,16 @@
 #define VAL_SOFT_RESET_VM_DATA      0x8E82
 #define VAL_SOFT_RESET_NVM_DATA     0x8E81
 
+// REPORT WINDOW - samples per report, about 0.5 s at the 500 us sample period
+#ifndef TLX49012_WINDOW_SAMPLES
+#define TLX49012_WINDOW_SAMPLES     1000
+#endif
+
+// ANGLE-ERROR COMPENSATION - fitted at start-up while the magnet turns at constant speed, off by default
+#ifndef TLX49012_COMPENSATION_ENABLE
+#define TLX49012_COMPENSATION_ENABLE    0
+#endif
+
 
 
 /*********************************************************************************************************************/
@@ -76,10 +92,39 @@
  static uint16 g_CRC_raw = 0;
  static uint16 g_angle_raw = 0;
  static uint16 g_status_raw = 0;
+ static uint8 g_error_raw = 0;
 
 /*********************************************************************************************************************/
 /*-------------------------------------------------Data Structures---------------------------------------------------*/
 /*********************************************************************************************************************/
+/* One sample, handed from the acquisition core to the reporting core */
+typedef struct
+{
+    uint16 angleRaw;                                                        /* Angle [LSB16], last valid frame      */
+    uint8  status;                                                          /* Device status, last valid frame      */
+    uint8  crc;                                                             /* CRC, last valid frame                */
+    uint8  error;                                                           /* Check result of this read            */
+} TLx49012_Sample;
+
+/* Aggregate of the samples of one report window. Angles are kept as positions from the first valid angle of the
+ * window, unwrapped by adding up the signed 16-bit steps between valid samples: a window crossing 0 degrees needs no
+ * special case, and a window may span any number of turns. Consecutive valid samples have to be less than 180
+ * degrees apart.
+ */
+typedef struct
+{
+    uint32 length;                                                          /* Samples per window                   */
+    uint32 count;                                                           /* Samples so far                       */
+    uint32 errors;                                                          /* Samples failing the check            */
+    uint32 crcErrors;                                                       /* ... of them CRC errors               */
+    uint16 reference;                                                       /* First valid angle [LSB16]            */
+    uint16 previous;                                                        /* Last valid angle [LSB16]             */
+    sint32 position;                                                        /* Last valid angle, from reference     */
+    sint32 minOffset;                                                       /* Smallest position                    */
+    sint32 maxOffset;                                                       /* Largest position                     */
+    sint64 sumOffset;                                                       /* Sum of the valid positions           */
+    uint32 statusBits[8];                                                   /* Valid samples with status bit n set  */
+} TLx49012_Window;
  
 /*********************************************************************************************************************/
 /*--------------------------------------------Private Variables/Constants--------------------------------------------*/
@@ -94,6 +139,7 @@
  * \brief   Initializes the sensor through a series of SPI commands.
             Soft-resets the sensor.
             Disables self-calibration.
+            Reads the user configuration area back into g_usrConfig.
  ******************************************************************************/
 void TLx49012_Init(void);
 
@@ -101,28 +147,101 @@ void TLx49012_Init(void);
 /*******************************************************************************
  * Function Name: TLx49012_GetAngleLSB
  ***************************************************************************//**
- * \brief   Reads the internal register at address 15 via SPI.
- * \return  Angle value in LSB, 16-bit.
+ * \brief   Reads the internal register at address 12 via SPI. A response
+ *          failing the CRC or status check is dropped.
+ * \param   angleLSB  Angle value in LSB, 16-bit, left unchanged on error.
+ * \return  FALSE if the response failed the check.
  ******************************************************************************/
-uint16 TLx49012_GetAngleLSB(void);
+boolean TLx49012_GetAngleLSB(uint16 *angleLSB);
 
 
 /*******************************************************************************
  * Function Name: TLx49012_GetAngleDegrees
  ***************************************************************************//**
- * \brief   Reads the internal register at address 12 via SPI.
- * \return  Angle value in degrees, double precision.
+ * \brief   Reads the internal register at address 12 via SPI. A response
+ *          failing the CRC or status check is dropped.
+ * \param   angleDegrees  Angle value in degrees, double precision, left
+ *                        unchanged on error.
+ * \return  FALSE if the response failed the check.
+ ******************************************************************************/
+boolean TLx49012_GetAngleDegrees(double *angleDegrees);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_GetSample
+ ***************************************************************************//**
+ * \brief   Reads the internal register at address 12 via SPI and packs the
+ *          frame for the reporting core, without floating-point math.
+ *          After a failed check the sample holds the last valid frame and
+ *          the error of this read.
+ * \param   sample  Sample to fill.
+ * \return  FALSE if the response failed the check.
+ ******************************************************************************/
+boolean TLx49012_GetSample(TLx49012_Sample *sample);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_GetAngleLSBCompensated
+ ***************************************************************************//**
+ * \brief   Reads the angle with TLx49012_GetAngleLSB and corrects it with
+ *          the fitted angle-error harmonics.
+ * \param   angleLSB  Corrected angle in LSB, 16-bit, left unchanged on
+ *                    error.
+ * \param   comp      Compensation, fitted or not - unfitted it leaves the
+ *                    angle as read.
+ * \return  FALSE if the response failed the check.
+ ******************************************************************************/
+boolean TLx49012_GetAngleLSBCompensated(uint16 *angleLSB, const TLx49012_Compensation *comp);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_CalibrateCompensation
+ ***************************************************************************//**
+ * \brief   Fits the angle-error compensation. Collects TLX49012_COMP_SAMPLES
+ *          angles every 500 us while the magnet turns at constant speed, a
+ *          failed read starts the collection over. Reports the harmonics and
+ *          the error left through UART.
+ * \param   comp  Compensation to fit.
+ * \return  FALSE if the angles covered less than one revolution, the angle
+ *          is then left uncorrected.
+ ******************************************************************************/
+boolean TLx49012_CalibrateCompensation(TLx49012_Compensation *comp);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_WindowInit
+ ***************************************************************************//**
+ * \brief   Starts an empty report window.
+ * \param   window  Window to clear.
+ * \param   length  Samples per window, e.g. TLX49012_WINDOW_SAMPLES.
+ ******************************************************************************/
+void TLx49012_WindowInit(TLx49012_Window *window, uint32 length);
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_WindowAdd
+ ***************************************************************************//**
+ * \brief   Adds a sample to the window, in constant time. Of a sample
+ *          failing the check only the error is counted, as it carries the
+ *          angle and status of the last valid frame.
+ * \param   window  Window to add to.
+ * \param   sample  Sample taken by the acquisition core.
+ * \return  TRUE once the window holds its length of samples.
  ******************************************************************************/
-double TLx49012_GetAngleDegrees(void);
+boolean TLx49012_WindowAdd(TLx49012_Window *window, const TLx49012_Sample *sample);
 
 
 /*******************************************************************************
- * Function Name: TLx49012_PrintSerialData
+ * Function Name: TLx49012_PrintWindow
  ***************************************************************************//**
- * \brief   Pushes through UART the values stored in the global variables
- *        of Device Status, Raw Angle, CRC, Angle [degrees]
+ * \brief   Pushes through UART the aggregate of a window: sample and error
+ *        counts, mean, minimum and maximum angle [degrees], the span
+ *        between minimum and maximum, and how many samples had each status
+ *        bit set.
+ * \param   window   Window to report.
+ * \param   dropped  Samples lost on a full queue since the previous window.
  ******************************************************************************/
-void TLx49012_PrintSerialData(void);
+void TLx49012_PrintWindow(const TLx49012_Window *window, uint32 dropped);
 
 
 #endif /* SRC_TLX49012_TLX49012_TLX49012_H_ */
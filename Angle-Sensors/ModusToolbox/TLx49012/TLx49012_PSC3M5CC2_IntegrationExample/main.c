@@ -42,7 +42,7 @@
 
 /**
  * @file        TLx49012_PSC3M5_Integration_Example
- * @version     1.1.0
+ * @version     1.2.0
  * @date        2026-04-08
  * @description This example code provides a starting point in interfacing the 
  *              TLx49012 angle sensors with the KIT_PSC3M5_CC2 evaluation board.
@@ -50,6 +50,7 @@
  * @changelog
  *   v1.0.0 - Initial release
  *   v1.1.0 - Soft-fuse procedure and register updates
+ *   v1.2.0 - Built on the shared TLx49012_PSC3M5_Library, one sensor on slave select 0
  */
 
 /*******************************************************************************
@@ -65,10 +66,19 @@
 #include "src/Sensor/TLx49012.h"
 
 
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ACQUISITION_RATE_HZ		(20U)	// Readout rate, timer driven
+#define PROFILE_DUMP_CYCLES		(ACQUISITION_RATE_HZ * 10U)	// Section timings printed every 10s when profiling
+
+
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
 uint16_t angle_LSB;		// Angle value received via SPI.
+
+TLx49012_InitStatus init_status[TLX49012_SENSOR_COUNT];	// Result of the sensor initialization
     
 
 /*******************************************************************************
@@ -102,22 +112,40 @@ int main(void)
 	// Fully initialize peripherals, with SPI interrupt and UART HAL
 	PSC3M5_MCU_Init();
 
-	// Initialize CRC LUT and soft-fuse the sensor
-	TLx49012_Init();
+	// Soft-fuse the sensor
+	if(false == TLx49012_Init(init_status))
+	{
+		CY_ASSERT(0);
+	}
 
     // Enable global interrupts
     __enable_irq();
     
+	// Start periodic acquisition
+	PSC3M5_Scheduler_Init(ACQUISITION_RATE_HZ);
+    
     for (;;)
     {	
-		// Send SPI read command and get LSB angle value
-		angle_LSB = TLx49012_GetAngleLSB();
-		
-		// Print to serial port the angle in both LSB and degrees
-		PSC3M5_UART_SendAngleInfo(angle_LSB);
-		
-		// ~20Hz readout
-		Cy_SysLib_Delay(50);
+		// Wait for the next acquisition period - rate does not depend on loop time
+		PSC3M5_Scheduler_WaitTick();
+
+		// Send SPI read command and get LSB angle value - a corrupted response is dropped
+		if(TLx49012_GetAngleLSB(&angle_LSB, SPI_SLAVE0))
+		{
+			// Print to serial port the angle in both LSB and degrees
+			PSC3M5_UART_SendAngleInfo(angle_LSB, SPI_SLAVE0);
+		}
+		else
+		{
+			PSC3M5_LOG1(RESPONSE_ERROR, SPI_SLAVE0);
+		}
+
+#if PSC3M5_PROFILE_ENABLE
+		if((PSC3M5_Scheduler_GetStats()->cycles % PROFILE_DUMP_CYCLES) == 0)
+		{
+			PSC3M5_Profile_Dump();
+		}
+#endif
     }
 }
 
@@ -0,0 +1,64 @@
+#include "SampleRing.h"
+
+
+void SampleRing_Init(SampleRing *ring)
+{
+	ring->head      = 0;
+	ring->tail      = 0;
+	ring->overflows = 0;
+	ring->gap       = false;
+}
+
+bool SampleRing_Push(SampleRing *ring, const AngleSample *sample)
+{
+	uint32_t head = ring->head;
+
+	if((head - ring->tail) == SAMPLE_RING_LENGTH)
+	{
+		ring->overflows++;
+		ring->gap = true;
+		return false;
+	}
+
+	// The consumer read this slot before it advanced tail
+	SAMPLE_RING_BARRIER();
+
+	ring->buffer[head & SAMPLE_RING_MASK] = *sample;
+
+	if(ring->gap)
+	{
+		ring->buffer[head & SAMPLE_RING_MASK].flags |= ANGLE_SAMPLE_GAP;
+		ring->gap = false;
+	}
+
+	// Record complete before it is published
+	SAMPLE_RING_BARRIER();
+	ring->head = head + 1;
+
+	return true;
+}
+
+uint32_t SampleRing_Pop(SampleRing *ring, AngleSample *samples, uint32_t maxCount)
+{
+	uint32_t tail  = ring->tail;
+	uint32_t count = ring->head - tail;
+
+	if(count > maxCount)
+	{
+		count = maxCount;
+	}
+
+	// Records published before head are visible
+	SAMPLE_RING_BARRIER();
+
+	for(uint32_t i = 0; i < count; i++)
+	{
+		samples[i] = ring->buffer[(tail + i) & SAMPLE_RING_MASK];
+	}
+
+	// Copies done before the slots are handed back
+	SAMPLE_RING_BARRIER();
+	ring->tail = tail + count;
+
+	return count;
+}
@@ -0,0 +1,90 @@
+#ifndef SRC_ACQUISITION_SAMPLERING_H_
+#define SRC_ACQUISITION_SAMPLERING_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "src/Sensor/TLx49012.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Number of sample records, power of two
+#define SAMPLE_RING_LENGTH				32U
+#define SAMPLE_RING_MASK				(SAMPLE_RING_LENGTH - 1U)
+
+// Sample flags, one bit per sensor for up to SPI_SLAVE_SELECT_COUNT sensors
+#define ANGLE_SAMPLE_STALE(slave)		(0x0001U << (slave))	// readStatus set or sensor inactive - no new angle
+#define ANGLE_SAMPLE_TRIGGERED(slave)	(0x0010U << (slave))	// triggerStatus set
+#define ANGLE_SAMPLE_ERROR(slave)		(0x0100U << (slave))	// Response failed the check - also stale
+#define ANGLE_SAMPLE_GAP				0x8000U					// Samples were dropped right before this one
+#define ANGLE_SAMPLE_STALE_ANY			((uint16_t)TLX49012_ALL_SENSORS)	// Any sensor without a new angle
+
+// Producer/consumer ordering: data before index, index before data
+#if defined(__linux__)
+#define SAMPLE_RING_BARRIER()			__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#include "cmsis_compiler.h"
+#define SAMPLE_RING_BARRIER()			__DMB()
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// One synchronized acquisition of all sensors
+typedef struct
+{
+	uint32_t timestamp;										// Completion time, scheduler clock ticks
+	AngleSyncRegister syncRegister[TLX49012_SENSOR_COUNT];	// Raw sync registers, indexed by slave
+	uint16_t flags;											// ANGLE_SAMPLE_* flags
+} AngleSample;
+
+// Single-producer/single-consumer ring. head is only written by the producer,
+// tail only by the consumer, so neither side needs a lock or a critical section.
+typedef struct
+{
+	AngleSample buffer[SAMPLE_RING_LENGTH];
+	volatile uint32_t head;			// Free running, next record to write
+	volatile uint32_t tail;			// Free running, next record to read
+	volatile uint32_t overflows;	// Samples dropped because the ring was full
+	bool gap;						// Producer side: next sample follows a drop
+} SampleRing;
+
+
+/*******************************************************************************
+ * Function Name: SampleRing_Init
+ ***************************************************************************//**
+ * \brief  Empties the ring and clears the overflow counter. Call before the
+ *         producer is started.
+ * \param  ring  Sample ring.
+ ******************************************************************************/
+void SampleRing_Init(SampleRing *ring);
+
+/*******************************************************************************
+ * Function Name: SampleRing_Push
+ ***************************************************************************//**
+ * \brief  Producer side. Safe to call from an ISR or a DMA/SPI completion
+ *         callback. A full ring drops the sample and counts an overflow; the
+ *         next stored sample carries ANGLE_SAMPLE_GAP.
+ * \param  ring    Sample ring.
+ * \param  sample  Record to copy into the ring.
+ * \return false if the sample was dropped.
+ ******************************************************************************/
+bool SampleRing_Push(SampleRing *ring, const AngleSample *sample);
+
+/*******************************************************************************
+ * Function Name: SampleRing_Pop
+ ***************************************************************************//**
+ * \brief  Consumer side. Copies out up to maxCount records, oldest first, and
+ *         releases them in one step.
+ * \param  ring      Sample ring.
+ * \param  samples   Destination array.
+ * \param  maxCount  Size of the destination array.
+ * \return Number of records copied.
+ ******************************************************************************/
+uint32_t SampleRing_Pop(SampleRing *ring, AngleSample *samples, uint32_t maxCount);
+
+
+#endif /* SRC_ACQUISITION_SAMPLERING_H_ */
@@ -0,0 +1,183 @@
+#include "Bench.h"
+
+#if PSC3M5_BENCH_ENABLE
+
+#include "src/MCU/Scheduler/Scheduler.h"
+#include "src/Sensor/ConfigShadow.h"
+#include <stdio.h>
+
+#ifndef PSC3M5_SCHEDULER_HOST
+#include "cy_pdl.h"
+#endif
+
+
+#if (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_BLOCKING)
+#define BENCH_TRANSPORT_NAME	"blocking"
+#elif (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_INTERRUPT)
+#define BENCH_TRANSPORT_NAME	"interrupt"
+#elif (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_DMA)
+#define BENCH_TRANSPORT_NAME	"dma"
+#else
+#define BENCH_TRANSPORT_NAME	"sim"
+#endif
+
+static const char * const workload_name[PSC3M5_BENCH_COUNT] =
+{
+	"angle",
+	"sync",
+	"config",
+};
+
+static const uint32_t bit_rates_hz[] = { PSC3M5_BENCH_BIT_RATES_HZ };
+
+// Per-sensor copy of the configuration area, written back unchanged by the config workload
+static TLx49012_RegisterValue bench_config[TLX49012_SENSOR_COUNT][TLX49012_SHADOW_COUNT];
+
+
+static uint32_t bench_now(void)
+{
+#ifdef PSC3M5_SPI_BACKEND_SIM
+	// Host CPU time plus simulated SPI time
+	return PSC3M5_Scheduler_PortNow() + PSC3M5_SPI_PortNow();
+#else
+	return PSC3M5_Scheduler_PortNow();
+#endif
+}
+
+static uint32_t ticks_to_us(uint32_t ticks)
+{
+	return (uint32_t)(((uint64_t)ticks * 1000000U) / PSC3M5_Scheduler_PortClockHz());
+}
+
+// Reads the configuration area of all active sensors, to be written back as is
+static void load_config(const TLx49012_Group *group)
+{
+	TLx49012_ShadowRefresh(group->active);
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		for(uint8_t i = 0; i < TLX49012_SHADOW_COUNT; i++)
+		{
+			bench_config[slave][i].addr = TLX49012_SHADOW_FIRST_ADDR + i;
+			bench_config[slave][i].data = 0;
+			TLx49012_ShadowGet(bench_config[slave][i].addr, &bench_config[slave][i].data, slave);
+		}
+	}
+}
+
+// One operation of a workload, returns when its result is in
+static void run_operation(TLx49012_Group *group, PSC3M5_BenchWorkload workload, uint32_t n)
+{
+	uint16_t angle;
+
+	switch(workload)
+	{
+		case PSC3M5_BENCH_ANGLE:
+			(void)TLx49012_GetAngleLSB(&angle, group->readPlan[n % group->readCount].slaveSelect);
+			break;
+
+		case PSC3M5_BENCH_SYNC:
+			(void)TLx49012_GroupSync(group, NULL);
+			while(group->readPending)
+			{
+				PSC3M5_SPI_Wait(&group->readPlan[group->readCount - 1]);
+			}
+			break;
+
+		default:
+			for(uint8_t i = 0; i < group->readCount; i++)
+			{
+				uint8_t slave = group->readPlan[i].slaveSelect;
+
+				// Forgetting the shadow forces every register to be written
+				TLx49012_ShadowInvalidate((uint8_t)(1U << slave));
+				(void)TLx49012_Configure(bench_config[slave], TLX49012_SHADOW_COUNT, (uint8_t)(1U << slave));
+			}
+			break;
+	}
+}
+
+
+void PSC3M5_Bench_RunWorkload(TLx49012_Group *group, PSC3M5_BenchWorkload workload, PSC3M5_BenchResult *result)
+{
+	uint32_t count = (workload == PSC3M5_BENCH_CONFIG) ? PSC3M5_BENCH_BURSTS : PSC3M5_BENCH_ITERATIONS;
+	uint32_t frames_start;
+	uint32_t idle_start;
+	uint32_t run_start;
+
+	*result = (PSC3M5_BenchResult){ 0 };
+
+	if(group->readCount == 0)
+	{
+		return;
+	}
+
+	if(workload == PSC3M5_BENCH_CONFIG)
+	{
+		load_config(group);
+	}
+
+	frames_start = PSC3M5_SPI_GetFrameCount();
+	idle_start   = PSC3M5_SPI_PortIdleTicks();
+	run_start    = bench_now();
+
+	for(uint32_t n = 0; n < count; n++)
+	{
+		uint32_t start = bench_now();
+		uint32_t latency;
+
+		run_operation(group, workload, n);
+
+		latency = bench_now() - start;
+		if(latency > result->maxLatencyTicks)
+		{
+			result->maxLatencyTicks = latency;
+		}
+	}
+
+	result->operations   = count;
+	result->elapsedTicks = bench_now() - run_start;
+	result->busyTicks    = result->elapsedTicks - (PSC3M5_SPI_PortIdleTicks() - idle_start);
+	result->frames       = PSC3M5_SPI_GetFrameCount() - frames_start;
+}
+
+void PSC3M5_Bench_Run(TLx49012_Group *group)
+{
+	PSC3M5_BenchResult result;
+
+#ifndef PSC3M5_SCHEDULER_HOST
+	// Timestamps before the scheduler runs
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	printf("BENCH,transport,sensors,bit_rate_hz,workload,operations,frames,elapsed_us,frames_per_s,busy_permille,max_latency_us\r\n");
+
+	for(uint8_t r = 0; r < (sizeof(bit_rates_hz) / sizeof(bit_rates_hz[0])); r++)
+	{
+		uint32_t bit_rate_hz = PSC3M5_SPI_SetBitRate(bit_rates_hz[r]);
+
+		for(uint8_t w = 0; w < PSC3M5_BENCH_COUNT; w++)
+		{
+			PSC3M5_Bench_RunWorkload(group, (PSC3M5_BenchWorkload)w, &result);
+
+			if(result.elapsedTicks == 0)
+			{
+				continue;
+			}
+
+			printf("BENCH,%s,%u,%lu,%s,%lu,%lu,%lu,%lu,%lu,%lu\r\n", BENCH_TRANSPORT_NAME, group->readCount,
+				   (unsigned long)bit_rate_hz, workload_name[w], (unsigned long)result.operations,
+				   (unsigned long)result.frames, (unsigned long)ticks_to_us(result.elapsedTicks),
+				   (unsigned long)(((uint64_t)result.frames * PSC3M5_Scheduler_PortClockHz()) / result.elapsedTicks),
+				   (unsigned long)(((uint64_t)result.busyTicks * 1000U) / result.elapsedTicks),
+				   (unsigned long)ticks_to_us(result.maxLatencyTicks));
+		}
+	}
+
+	(void)PSC3M5_SPI_SetBitRate(SPI_BIT_RATE_HZ);
+}
+
+#endif /* PSC3M5_BENCH_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,73 @@
+#ifndef SRC_BENCH_BENCH_H_
+#define SRC_BENCH_BENCH_H_
+
+
+#include "stdint.h"
+#include "src/Sensor/SensorGroup.h"
+
+// SPI transport benchmark, off by default. Enable with DEFINES+=PSC3M5_BENCH_ENABLE=1 in the
+// Makefile; the transport is the one selected by PSC3M5_SPI_TRANSPORT, so one build per transport.
+#ifndef PSC3M5_BENCH_ENABLE
+#define PSC3M5_BENCH_ENABLE			0
+#endif
+
+// Workload size, per SCLK rate
+#ifndef PSC3M5_BENCH_ITERATIONS
+#define PSC3M5_BENCH_ITERATIONS		(1000U)		// Angle reads, sync cycles
+#endif
+#ifndef PSC3M5_BENCH_BURSTS
+#define PSC3M5_BENCH_BURSTS			(50U)		// Configuration bursts
+#endif
+
+// SCLK rates swept, SCB clock / 10, 8, 5 and 4 with the Device Configurator settings
+#ifndef PSC3M5_BENCH_BIT_RATES_HZ
+#define PSC3M5_BENCH_BIT_RATES_HZ	1000000U, 1250000U, 2000000U, 2500000U
+#endif
+
+
+// Fixed workloads
+typedef enum
+{
+	PSC3M5_BENCH_ANGLE,		// TLx49012_GetAngleLSB() of each active sensor in turn, one frame each
+	PSC3M5_BENCH_SYNC,		// TLx49012_GroupSync() until the group read is in
+	PSC3M5_BENCH_CONFIG,	// Whole user configuration area written and read back, per sensor
+	PSC3M5_BENCH_COUNT
+} PSC3M5_BenchWorkload;
+
+// One workload run, in timestamp clock ticks (CPU cycles on target, ns on host)
+typedef struct
+{
+	uint32_t operations;		// Workload operations run
+	uint32_t frames;			// SPI frames sent
+	uint32_t elapsedTicks;		// Whole run
+	uint32_t busyTicks;			// CPU not sleeping for the SPI transport
+	uint32_t maxLatencyTicks;	// Longest operation, start to result
+} PSC3M5_BenchResult;
+
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Bench_RunWorkload
+ ***************************************************************************//**
+ * \brief  Runs one workload at the current SCLK rate and measures it. On a
+ *         Linux host the elapsed time is the host CPU time plus the modelled
+ *         wire time of the simulation, which counts as idle.
+ * \param  group     Initialized sensor group, its active sensors are used.
+ * \param  workload  Workload to run.
+ * \param  result    Measurements.
+ ******************************************************************************/
+void PSC3M5_Bench_RunWorkload(TLx49012_Group *group, PSC3M5_BenchWorkload workload, PSC3M5_BenchResult *result);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Bench_Run
+ ***************************************************************************//**
+ * \brief  Runs all workloads at every PSC3M5_BENCH_BIT_RATES_HZ rate and
+ *         prints one CSV line per run, prefixed with BENCH, after a header
+ *         line. The configured SCLK rate is restored at the end. Call
+ *         before PSC3M5_Scheduler_Init(), the scheduler tick would add to
+ *         the busy time.
+ * \param  group  Initialized sensor group, its active sensors are used.
+ ******************************************************************************/
+void PSC3M5_Bench_Run(TLx49012_Group *group);
+
+
+#endif /* SRC_BENCH_BENCH_H_ */
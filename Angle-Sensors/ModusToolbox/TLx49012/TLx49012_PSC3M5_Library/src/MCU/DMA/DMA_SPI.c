@@ -1,4 +1,9 @@
-#include <DMA_SPI.h>
+#include "src/MCU/SPI/SPI_Backend.h"
+
+// Needs the txDma/rxDma channels of the DMA project's device configuration
+#if (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_DMA)
+
+#include "DMA_SPI.h"
 #include "cycfg_dmas.h"
 
 
@@ -140,9 +145,7 @@ uint32_t configure_rx_dma(uint8_t* rx_buffer)
       /* Enable DMA interrupt source. */
      Cy_DMA_Channel_SetInterruptMask(rxDma_HW, rxDma_CHANNEL, CY_DMA_INTR_MASK);
      
-     /* Enable channel and DMA block to start descriptor execution process */
-     Cy_DMA_Channel_Enable(rxDma_HW, rxDma_CHANNEL);
-     
+     /* Enable DMA block - the channel is enabled per frame by start_dma_frame() */
      Cy_DMA_Enable(rxDma_HW);
      return INIT_SUCCESS;
 }
@@ -165,6 +168,10 @@ void rx_dma_complete(void)
     {
         /* Get the interrupt cause */
         cy_en_dma_intr_cause_t cause = Cy_DMA_Channel_GetStatus(rxDma_HW, rxDma_CHANNEL);
+
+        /* Clear the interrupt before the next frame can complete */
+        Cy_DMA_Channel_ClearInterrupt(rxDma_HW, rxDma_CHANNEL);
+
         if (CY_DMA_INTR_CAUSE_COMPLETION != cause)
         {
             /* DMA error occurred while RX operations */
@@ -173,9 +180,36 @@ void rx_dma_complete(void)
         else
         {
             rx_dma_done = true;
-        }
 
-        /* Clear the interrupt */
-        Cy_DMA_Channel_ClearInterrupt(rxDma_HW, rxDma_CHANNEL);
+            /* Complete the frame and start the next queued one, if any */
+            PSC3M5_SPI_FrameDone();
+        }
     }
 }
+
+/******************************************************************************
+* Function Name: start_dma_frame
+*******************************************************************************
+*
+* Summary:      This function points both descriptors to a new 4-byte frame
+*               and starts the transfer. RX is armed before TX so that no
+*               received byte is lost.
+*
+* Parameters:   tx_frame, rx_frame
+*
+* Return:       None
+*
+******************************************************************************/
+void start_dma_frame(const uint8_t* tx_frame, uint8_t* rx_frame)
+{
+     Cy_DMA_Descriptor_SetDstAddress(&rxDma_Descriptor_0, (void *)rx_frame);
+     Cy_DMA_Descriptor_SetSrcAddress(&txDma_Descriptor_0, (const void *)tx_frame);
+
+     Cy_DMA_Channel_SetDescriptor(rxDma_HW, rxDma_CHANNEL, &rxDma_Descriptor_0);
+     Cy_DMA_Channel_SetDescriptor(txDma_HW, txDma_CHANNEL, &txDma_Descriptor_0);
+
+     Cy_DMA_Channel_Enable(rxDma_HW, rxDma_CHANNEL);
+     Cy_DMA_Channel_Enable(txDma_HW, txDma_CHANNEL);
+}
+
+#endif /* PSC3M5_SPI_TRANSPORT_DMA */
@@ -33,6 +33,7 @@ uint32_t configure_tx_dma(uint8_t* txBuffer);
 void tx_dma_complete(void);
 uint32_t configure_rx_dma(uint8_t* rxBuffer);
 void rx_dma_complete(void);
+void start_dma_frame(const uint8_t* tx_frame, uint8_t* rx_frame);
 void handle_error(void);
 
 
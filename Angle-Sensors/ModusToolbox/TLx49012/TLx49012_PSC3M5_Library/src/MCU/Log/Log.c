@@ -0,0 +1,220 @@
+#include "Log.h"
+
+#if PSC3M5_LOG_ENABLE
+
+#include "src/MCU/Scheduler/Scheduler.h"		// PSC3M5_SCHEDULER_HOST
+
+
+PSC3M5_LogRing PSC3M5_Log_Ring;
+
+// Message being sent, encoded - drain side only
+static uint8_t message[PSC3M5_LOG_MESSAGE_MAX];
+static uint8_t message_length;
+static uint8_t message_sent;
+
+
+// Hands bytes to the UART, returns how many it took
+static uint32_t PSC3M5_Log_PortPut(const uint8_t *bytes, uint32_t length);
+static void PSC3M5_Log_PortStart(void);
+
+
+// Wire format of one message, returns its length
+static uint8_t encode(uint8_t *out, const PSC3M5_LogRecord *record)
+{
+	uint8_t length = 0;
+
+	out[length++] = PSC3M5_LOG_SYNC;
+	out[length++] = record->id;
+	out[length++] = record->count;
+
+	for(uint8_t i = 0; i < record->count; i++)
+	{
+		uint32_t value = record->arg[i];
+
+		while(value >= 0x80U)
+		{
+			out[length++] = (uint8_t)(value | 0x80U);
+			value >>= 7;
+		}
+		out[length++] = (uint8_t)value;
+	}
+
+	return length;
+}
+
+
+void PSC3M5_Log_Init(void)
+{
+	PSC3M5_Log_Ring.head      = 0;
+	PSC3M5_Log_Ring.tail      = 0;
+	PSC3M5_Log_Ring.overflows = 0;
+	PSC3M5_Log_Ring.lost      = 0;
+
+	message_length = 0;
+	message_sent   = 0;
+
+	PSC3M5_Log_PortStart();
+}
+
+bool PSC3M5_Log_Recover(void)
+{
+	uint32_t head = PSC3M5_Log_Ring.head;
+	uint32_t room = PSC3M5_LOG_RING_LENGTH - (head - PSC3M5_Log_Ring.tail);
+	PSC3M5_LogRecord *record;
+
+	if(room == 0)
+	{
+		PSC3M5_Log_Ring.overflows++;
+		PSC3M5_Log_Ring.lost++;
+		return false;
+	}
+
+	// The last free slot carries the drop notice, which then includes this message
+	if(room == 1)
+	{
+		PSC3M5_Log_Ring.overflows++;
+		PSC3M5_Log_Ring.lost++;
+	}
+
+	PSC3M5_LOG_BARRIER();
+
+	record = &PSC3M5_Log_Ring.record[head & PSC3M5_LOG_RING_MASK];
+	record->id     = PSC3M5_LOG_ID_DROPPED;
+	record->count  = 1;
+	record->arg[0] = PSC3M5_Log_Ring.lost;
+	PSC3M5_Log_Ring.lost = 0;
+
+	PSC3M5_LOG_BARRIER();
+	PSC3M5_Log_Ring.head = head + 1;
+
+	return (room > 1);
+}
+
+bool PSC3M5_Log_Drain(void)
+{
+	for(;;)
+	{
+		uint32_t tail = PSC3M5_Log_Ring.tail;
+
+		// Rest of the current message first, whole messages keep the stream decodable
+		if(message_sent < message_length)
+		{
+			message_sent += (uint8_t)PSC3M5_Log_PortPut(&message[message_sent], message_length - message_sent);
+
+			if(message_sent < message_length)
+			{
+				return false;
+			}
+		}
+
+		if(tail == PSC3M5_Log_Ring.head)
+		{
+			return true;
+		}
+
+		// Records published before head are visible
+		PSC3M5_LOG_BARRIER();
+
+		message_length = encode(message, &PSC3M5_Log_Ring.record[tail & PSC3M5_LOG_RING_MASK]);
+		message_sent   = 0;
+
+		// Record encoded before the slot is handed back
+		PSC3M5_LOG_BARRIER();
+		PSC3M5_Log_Ring.tail = tail + 1;
+	}
+}
+
+
+#ifndef PSC3M5_SCHEDULER_HOST
+
+#include "cy_pdl.h"
+#include "cycfg_peripherals.h"
+
+// Below the SPI and DMA interrupts, sending is never urgent
+#define LOG_UART_INTR_PRIORITY		(7U)
+
+
+// TX FIFO below its trigger level: refill, then go quiet once the ring is empty
+static void PSC3M5_Log_Interrupt(void)
+{
+	if(PSC3M5_Log_Drain())
+	{
+		Cy_SCB_SetTxInterruptMask(UART_PC_HW, 0UL);
+	}
+
+	Cy_SCB_ClearTxInterrupt(UART_PC_HW, CY_SCB_UART_TX_TRIGGER);
+}
+
+static void PSC3M5_Log_PortStart(void)
+{
+	const cy_stc_sysint_t irq_cfg =
+	{
+		.intrSrc      = UART_PC_IRQ,
+		.intrPriority = LOG_UART_INTR_PRIORITY
+	};
+
+	// Refilled once half of the FIFO is out
+	Cy_SCB_SetTxFifoLevel(UART_PC_HW, Cy_SCB_GetFifoSize(UART_PC_HW) / 2UL);
+	Cy_SCB_SetTxInterruptMask(UART_PC_HW, 0UL);
+
+	if(Cy_SysInt_Init(&irq_cfg, &PSC3M5_Log_Interrupt) != CY_SYSINT_SUCCESS)
+	{
+		CY_ASSERT(0);
+	}
+
+	NVIC_EnableIRQ(UART_PC_IRQ);
+}
+
+static uint32_t PSC3M5_Log_PortPut(const uint8_t *bytes, uint32_t length)
+{
+	return Cy_SCB_UART_PutArray(UART_PC_HW, (void *)bytes, length);
+}
+
+void PSC3M5_Log_PortKick(void)
+{
+	Cy_SCB_SetTxInterruptMask(UART_PC_HW, CY_SCB_UART_TX_TRIGGER);
+}
+
+void PSC3M5_Log_Flush(void)
+{
+	bool idle = false;
+
+	// The interrupt is the only other consumer, keep it out while draining here
+	while(!idle)
+	{
+		NVIC_DisableIRQ(UART_PC_IRQ);
+		idle = PSC3M5_Log_Drain();
+		NVIC_EnableIRQ(UART_PC_IRQ);
+	}
+}
+
+#else
+
+#include <stdio.h>
+
+
+static void PSC3M5_Log_PortStart(void)
+{
+}
+
+// stdout never refuses, the stream goes to the decoder through a pipe
+static uint32_t PSC3M5_Log_PortPut(const uint8_t *bytes, uint32_t length)
+{
+	return (uint32_t)fwrite(bytes, 1, length, stdout);
+}
+
+void PSC3M5_Log_PortKick(void)
+{
+}
+
+void PSC3M5_Log_Flush(void)
+{
+	(void)PSC3M5_Log_Drain();
+	fflush(stdout);
+}
+
+#endif /* PSC3M5_SCHEDULER_HOST */
+
+#endif /* PSC3M5_LOG_ENABLE */
+
+/* [] END OF FILE */
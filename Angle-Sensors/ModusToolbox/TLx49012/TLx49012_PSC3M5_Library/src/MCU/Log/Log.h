@@ -0,0 +1,209 @@
+#ifndef SRC_MCU_LOG_LOG_H_
+#define SRC_MCU_LOG_LOG_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+#include <stdio.h>
+
+// Deferred binary logging, off by default. Enable with DEFINES+=PSC3M5_LOG_ENABLE=1 in the Makefile;
+// when off, every PSC3M5_LOG*() site prints its text right away with printf().
+#ifndef PSC3M5_LOG_ENABLE
+#define PSC3M5_LOG_ENABLE			0
+#endif
+
+// Messages held until sent, power of two
+#ifndef PSC3M5_LOG_RING_LENGTH
+#define PSC3M5_LOG_RING_LENGTH		64U
+#endif
+#define PSC3M5_LOG_RING_MASK		(PSC3M5_LOG_RING_LENGTH - 1U)
+
+#define PSC3M5_LOG_ARGS_MAX			5U
+
+// Wire format of a message: PSC3M5_LOG_SYNC, ID, argument count, then each argument as an unsigned
+// LEB128 varint (7 bits per byte, low bits first). 0xFF never occurs in ASCII or UTF-8 text, so
+// messages and printf() text can share the serial port.
+#define PSC3M5_LOG_SYNC				0xFFU
+#define PSC3M5_LOG_MESSAGE_MAX		(3U + (PSC3M5_LOG_ARGS_MAX * 5U))
+
+// Producer/consumer ordering: data before index, index before data
+#if defined(__linux__)
+#define PSC3M5_LOG_BARRIER()		__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#else
+#include "cmsis_compiler.h"
+#define PSC3M5_LOG_BARRIER()		__DMB()
+#endif
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Message Formats---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// One format per message, printf() conversions on unsigned long arguments. The host decoder
+// (tools/log_decode.py) reads the formats and the ID order from this file, so both stay in step
+// with the firmware. %m prints milli-units with 3 decimals and is known to the decoder only:
+// messages using it are never printed on target.
+#define PSC3M5_LOG_FMT_DROPPED			"LOG: %lu messages dropped"
+#define PSC3M5_LOG_FMT_ANGLE			"Sensor%lu ->ANGLE [LSB]: 0x%04lX | Sensor%lu ->ANGLE [deg]: %m"
+#define PSC3M5_LOG_FMT_FRESH_VALUES		"*** NEW FRESH VALUES ***"
+#define PSC3M5_LOG_FMT_SYNC_STATS		"SYNC fresh %lu partial %lu stale %lu error %lu delay %lu us"
+#define PSC3M5_LOG_FMT_SENSOR_STATS		"  S%lu fresh %lu stale %lu error %lu"
+#define PSC3M5_LOG_FMT_RESPONSE_ERROR	"ERROR: Sensor%lu response failed the check"
+
+// Message IDs on the wire, one per PSC3M5_LOG_FMT_<name>. Append only, the decoder counts them in order.
+typedef enum
+{
+	PSC3M5_LOG_ID_DROPPED,			// Messages lost to a full ring, written in their place
+	PSC3M5_LOG_ID_ANGLE,			// Slave, angle, slave, angle in milli-degrees
+	PSC3M5_LOG_ID_FRESH_VALUES,
+	PSC3M5_LOG_ID_SYNC_STATS,
+	PSC3M5_LOG_ID_SENSOR_STATS,
+	PSC3M5_LOG_ID_RESPONSE_ERROR,
+	PSC3M5_LOG_ID_COUNT
+} PSC3M5_LogId;
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// One message as written by the log site: raw arguments, no formatting
+typedef struct
+{
+	uint8_t id;							// PSC3M5_LogId
+	uint8_t count;						// Arguments used
+	uint32_t arg[PSC3M5_LOG_ARGS_MAX];
+} PSC3M5_LogRecord;
+
+// Single-producer/single-consumer ring. head is only written by the log sites, tail only by
+// the drain, so neither side needs a lock or a critical section.
+typedef struct
+{
+	PSC3M5_LogRecord record[PSC3M5_LOG_RING_LENGTH];
+	volatile uint32_t head;				// Free running, next record to write
+	volatile uint32_t tail;				// Free running, next record to send
+	volatile uint32_t overflows;		// Messages dropped because the ring was full
+	uint32_t lost;						// Producer side: drops not reported yet
+} PSC3M5_LogRing;
+
+extern PSC3M5_LogRing PSC3M5_Log_Ring;
+
+
+#if PSC3M5_LOG_ENABLE
+
+#define PSC3M5_LOG_INIT()						PSC3M5_Log_Init()
+#define PSC3M5_LOG_FLUSH()						PSC3M5_Log_Flush()
+#define PSC3M5_LOG0(name)						PSC3M5_Log_Write(PSC3M5_LOG_ID_##name, 0, 0, 0, 0, 0, 0)
+#define PSC3M5_LOG1(name, a0)					PSC3M5_Log_Write(PSC3M5_LOG_ID_##name, 1, (a0), 0, 0, 0, 0)
+#define PSC3M5_LOG2(name, a0, a1)				PSC3M5_Log_Write(PSC3M5_LOG_ID_##name, 2, (a0), (a1), 0, 0, 0)
+#define PSC3M5_LOG3(name, a0, a1, a2)			PSC3M5_Log_Write(PSC3M5_LOG_ID_##name, 3, (a0), (a1), (a2), 0, 0)
+#define PSC3M5_LOG4(name, a0, a1, a2, a3)		PSC3M5_Log_Write(PSC3M5_LOG_ID_##name, 4, (a0), (a1), (a2), (a3), 0)
+#define PSC3M5_LOG5(name, a0, a1, a2, a3, a4)	PSC3M5_Log_Write(PSC3M5_LOG_ID_##name, 5, (a0), (a1), (a2), (a3), (a4))
+
+#else
+
+// Same text, formatted and sent at the log site
+#define PSC3M5_LOG_INIT()						((void)0)
+#define PSC3M5_LOG_FLUSH()						((void)0)
+#define PSC3M5_LOG0(name)						printf(PSC3M5_LOG_FMT_##name "\r\n")
+#define PSC3M5_LOG1(name, a0)					printf(PSC3M5_LOG_FMT_##name "\r\n", (unsigned long)(a0))
+#define PSC3M5_LOG2(name, a0, a1)				printf(PSC3M5_LOG_FMT_##name "\r\n", (unsigned long)(a0), (unsigned long)(a1))
+#define PSC3M5_LOG3(name, a0, a1, a2)			printf(PSC3M5_LOG_FMT_##name "\r\n", (unsigned long)(a0), (unsigned long)(a1), \
+													   (unsigned long)(a2))
+#define PSC3M5_LOG4(name, a0, a1, a2, a3)		printf(PSC3M5_LOG_FMT_##name "\r\n", (unsigned long)(a0), (unsigned long)(a1), \
+													   (unsigned long)(a2), (unsigned long)(a3))
+#define PSC3M5_LOG5(name, a0, a1, a2, a3, a4)	printf(PSC3M5_LOG_FMT_##name "\r\n", (unsigned long)(a0), (unsigned long)(a1), \
+													   (unsigned long)(a2), (unsigned long)(a3), (unsigned long)(a4))
+
+#endif /* PSC3M5_LOG_ENABLE */
+
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Log_Init
+ ***************************************************************************//**
+ * \brief  Empties the ring and starts the drain: on target the TX FIFO
+ *         interrupt of the UART_PC block, which refills the FIFO while
+ *         messages are pending. Call after PSC3M5_UART_Init().
+ ******************************************************************************/
+void PSC3M5_Log_Init(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Log_Drain
+ ***************************************************************************//**
+ * \brief  Consumer side. Encodes the queued messages and hands them to the
+ *         UART until its TX FIFO is full. Never waits. Runs from the UART
+ *         interrupt on target; call PSC3M5_Log_Flush() from the main loop.
+ * \return true once all messages are sent.
+ ******************************************************************************/
+bool PSC3M5_Log_Drain(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Log_Flush
+ ***************************************************************************//**
+ * \brief  Waits until all queued messages are sent, e.g. before printf()
+ *         output that must not land inside a message. On a Linux host this
+ *         is the drain: messages are written to stdout.
+ ******************************************************************************/
+void PSC3M5_Log_Flush(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Log_Recover
+ ***************************************************************************//**
+ * \brief  Slow path of PSC3M5_Log_Write(), for a full ring or drops still to
+ *         be reported. Stores the PSC3M5_LOG_ID_DROPPED message once there
+ *         is room, so that it lands where the messages were lost.
+ * \return false if the new message has to be dropped.
+ ******************************************************************************/
+bool PSC3M5_Log_Recover(void);
+
+// Starts sending after new messages, on target re-enables the TX FIFO interrupt
+void PSC3M5_Log_PortKick(void);
+
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Log_Write
+ ***************************************************************************//**
+ * \brief  Producer side, used through the PSC3M5_LOG*() macros. Stores the
+ *         message ID and its raw arguments, nothing is formatted. Call from
+ *         one context only, the main loop in the examples. A full ring drops
+ *         the message; the drop is reported with the next one.
+ * \param  id     Message ID.
+ * \param  count  Arguments used, up to PSC3M5_LOG_ARGS_MAX.
+ * \param  a0-a4  Arguments, as expected by the message format.
+ ******************************************************************************/
+static inline void PSC3M5_Log_Write(PSC3M5_LogId id, uint8_t count, uint32_t a0, uint32_t a1, uint32_t a2,
+									uint32_t a3, uint32_t a4)
+{
+	PSC3M5_LogRecord *record;
+	uint32_t head;
+
+	if(((PSC3M5_Log_Ring.head - PSC3M5_Log_Ring.tail) == PSC3M5_LOG_RING_LENGTH) || (PSC3M5_Log_Ring.lost != 0))
+	{
+		if(!PSC3M5_Log_Recover())
+		{
+			return;
+		}
+	}
+
+	head = PSC3M5_Log_Ring.head;
+
+	// The drain read this slot before it advanced tail
+	PSC3M5_LOG_BARRIER();
+
+	// Constant counts fold the unused stores away
+	record = &PSC3M5_Log_Ring.record[head & PSC3M5_LOG_RING_MASK];
+	record->id    = (uint8_t)id;
+	record->count = count;
+	if(count > 0) { record->arg[0] = a0; }
+	if(count > 1) { record->arg[1] = a1; }
+	if(count > 2) { record->arg[2] = a2; }
+	if(count > 3) { record->arg[3] = a3; }
+	if(count > 4) { record->arg[4] = a4; }
+
+	// Record complete before it is published
+	PSC3M5_LOG_BARRIER();
+	PSC3M5_Log_Ring.head = head + 1;
+
+	PSC3M5_Log_PortKick();
+}
+
+
+#endif /* SRC_MCU_LOG_LOG_H_ */
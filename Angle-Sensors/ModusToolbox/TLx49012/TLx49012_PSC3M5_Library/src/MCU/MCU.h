@@ -4,12 +4,19 @@
 
 #include "SPI/SPI_Backend.h"
 #include "UART/UART.h"
+#include "Scheduler/Scheduler.h"
+#include "Timer/Timer.h"
+#include "Profile/Profile.h"
+#include "Log/Log.h"
 
 
 void PSC3M5_MCU_Init()
 {
+	PSC3M5_PROFILE_INIT();
 	PSC3M5_SPI_Init();
+	PSC3M5_Timer_Init();
 	PSC3M5_UART_Init();
+	PSC3M5_LOG_INIT();
 }
 
 #endif /* SRC_MCU_MCU_H_ */
@@ -0,0 +1,111 @@
+#include "Profile.h"
+
+#if PSC3M5_PROFILE_ENABLE
+
+#include "src/MCU/Log/Log.h"
+#include <stdio.h>
+
+#ifndef PSC3M5_SCHEDULER_HOST
+#include "cy_pdl.h"
+#endif
+
+
+static PSC3M5_ProfileStats stats[PSC3M5_PROFILE_COUNT];
+
+static const char * const section_name[PSC3M5_PROFILE_COUNT] =
+{
+	"SPI frame",
+	"SPI wait",
+	"CRC",
+	"UART",
+};
+
+
+void PSC3M5_Profile_Init(void)
+{
+#ifndef PSC3M5_SCHEDULER_HOST
+	// Counter keeps running - the scheduler resets it when it starts
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	PSC3M5_Profile_Reset();
+}
+
+void PSC3M5_Profile_Record(PSC3M5_ProfileSection section, uint32_t ticks)
+{
+	PSC3M5_ProfileStats *s = &stats[section];
+	uint8_t bin = 0;
+
+	while((bin < (PSC3M5_PROFILE_BINS - 1)) && ((ticks >> (bin + 1)) != 0))
+	{
+		bin++;
+	}
+
+	s->count++;
+	s->sumTicks += ticks;
+	s->histogram[bin]++;
+
+	if(ticks < s->minTicks)
+	{
+		s->minTicks = ticks;
+	}
+	if(ticks > s->maxTicks)
+	{
+		s->maxTicks = ticks;
+	}
+}
+
+const PSC3M5_ProfileStats * PSC3M5_Profile_GetStats(PSC3M5_ProfileSection section)
+{
+	return &stats[section];
+}
+
+void PSC3M5_Profile_Reset(void)
+{
+	for(uint8_t i = 0; i < PSC3M5_PROFILE_COUNT; i++)
+	{
+		stats[i] = (PSC3M5_ProfileStats){ 0 };
+		stats[i].minTicks = UINT32_MAX;
+	}
+}
+
+void PSC3M5_Profile_Dump(void)
+{
+	// Queued log messages out first, printf() text must not split one
+	PSC3M5_LOG_FLUSH();
+
+	printf("PROFILE clock %lu Hz\r\n", (unsigned long)PSC3M5_Scheduler_PortClockHz());
+
+	for(uint8_t i = 0; i < PSC3M5_PROFILE_COUNT; i++)
+	{
+		const PSC3M5_ProfileStats *s = &stats[i];
+
+		if(s->count == 0)
+		{
+			continue;
+		}
+
+		printf("  %-9s n %lu min %lu mean %lu max %lu\r\n", section_name[i], (unsigned long)s->count,
+			   (unsigned long)s->minTicks, (unsigned long)(s->sumTicks / s->count), (unsigned long)s->maxTicks);
+
+		// Bin b: below 2^(b+1) ticks, the last one at least 2^b
+		printf("   ");
+		for(uint8_t bin = 0; bin < (PSC3M5_PROFILE_BINS - 1); bin++)
+		{
+			if(s->histogram[bin] != 0)
+			{
+				printf(" <2^%u:%lu", bin + 1, (unsigned long)s->histogram[bin]);
+			}
+		}
+		if(s->histogram[PSC3M5_PROFILE_BINS - 1] != 0)
+		{
+			printf(" >=2^%u:%lu", PSC3M5_PROFILE_BINS - 1, (unsigned long)s->histogram[PSC3M5_PROFILE_BINS - 1]);
+		}
+		printf("\r\n");
+	}
+}
+
+#endif /* PSC3M5_PROFILE_ENABLE */
+
+/* [] END OF FILE */
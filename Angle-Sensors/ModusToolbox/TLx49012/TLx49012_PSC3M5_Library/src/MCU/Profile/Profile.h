@@ -0,0 +1,86 @@
+#ifndef SRC_MCU_PROFILE_PROFILE_H_
+#define SRC_MCU_PROFILE_PROFILE_H_
+
+
+#include "stdint.h"
+
+// Section profiling, off by default. Enable with DEFINES+=PSC3M5_PROFILE_ENABLE=1 in the Makefile;
+// when off, all PSC3M5_PROFILE_*() hooks compile to nothing.
+#ifndef PSC3M5_PROFILE_ENABLE
+#define PSC3M5_PROFILE_ENABLE		0
+#endif
+
+// Histogram bin b counts durations below 2^(b+1) ticks, the last bin everything longer
+#define PSC3M5_PROFILE_BINS			(24U)
+
+
+// Profiled code sections
+typedef enum
+{
+	PSC3M5_PROFILE_SPI_FRAME,		// PSC3M5_SPI_SendReceive(), whole frame
+	PSC3M5_PROFILE_SPI_WAIT,		// PSC3M5_SPI_Wait(), sleeping for the SPI/DMA completion
+	PSC3M5_PROFILE_CRC,				// CalcCRC()
+	PSC3M5_PROFILE_UART,			// PSC3M5_UART_Send*() line output
+	PSC3M5_PROFILE_COUNT
+} PSC3M5_ProfileSection;
+
+// Durations of one section, in timestamp clock ticks (CPU cycles on target, ns on host)
+typedef struct
+{
+	uint32_t count;								// Runs recorded
+	uint32_t minTicks;
+	uint32_t maxTicks;
+	uint64_t sumTicks;							// For the mean: sumTicks / count
+	uint32_t histogram[PSC3M5_PROFILE_BINS];	// log2 duration distribution
+} PSC3M5_ProfileStats;
+
+
+#if PSC3M5_PROFILE_ENABLE
+
+#include "src/MCU/Scheduler/Scheduler.h"
+
+// Timestamps come from the scheduler clock - DWT cycle counter on target, clock_gettime() on host
+#define PSC3M5_PROFILE_INIT()			PSC3M5_Profile_Init()
+#define PSC3M5_PROFILE_BEGIN(section)	uint32_t profile_start_##section = PSC3M5_Scheduler_PortNow()
+#define PSC3M5_PROFILE_END(section)		PSC3M5_Profile_Record((section), PSC3M5_Scheduler_PortNow() - profile_start_##section)
+#define PSC3M5_PROFILE_DUMP()			PSC3M5_Profile_Dump()
+
+#else
+
+#define PSC3M5_PROFILE_INIT()			((void)0)
+#define PSC3M5_PROFILE_BEGIN(section)	((void)0)
+#define PSC3M5_PROFILE_END(section)		((void)0)
+#define PSC3M5_PROFILE_DUMP()			((void)0)
+
+#endif /* PSC3M5_PROFILE_ENABLE */
+
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Profile_Init
+ ***************************************************************************//**
+ * \brief  Starts the DWT cycle counter, so that sections running before
+ *         PSC3M5_Scheduler_Init() are timed too, and clears all statistics.
+ ******************************************************************************/
+void PSC3M5_Profile_Init(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Profile_Record
+ ***************************************************************************//**
+ * \brief  Adds one duration to the statistics of a section. Main loop
+ *         context only, not reentrant.
+ * \param  section  Profiled section.
+ * \param  ticks    Duration, in timestamp clock ticks.
+ ******************************************************************************/
+void PSC3M5_Profile_Record(PSC3M5_ProfileSection section, uint32_t ticks);
+
+// Returns the statistics of a section
+const PSC3M5_ProfileStats * PSC3M5_Profile_GetStats(PSC3M5_ProfileSection section);
+
+// Clears the statistics of all sections
+void PSC3M5_Profile_Reset(void);
+
+// Prints min/mean/max and the non-empty histogram bins of all sections that ran
+void PSC3M5_Profile_Dump(void);
+
+
+#endif /* SRC_MCU_PROFILE_PROFILE_H_ */
@@ -0,0 +1,364 @@
+#include "SPI_Backend.h"
+#include "src/MCU/Profile/Profile.h"
+#include "src/MCU/Scheduler/Scheduler.h"
+#include <stdint.h>
+#include <stddef.h>
+
+
+// Submitted transactions, the oldest one is on the wire
+static PSC3M5_SPI_Transaction *queue[SPI_QUEUE_LENGTH];
+static volatile uint8_t queue_head;
+static volatile uint8_t queue_count;
+
+static volatile uint32_t frame_count;
+
+// Response check counters, indexed by slave select
+static volatile uint32_t slave_frames[SPI_SLAVE_SELECT_COUNT];
+static volatile uint32_t slave_crc_errors[SPI_SLAVE_SELECT_COUNT];
+static volatile uint32_t slave_status_errors[SPI_SLAVE_SELECT_COUNT];
+
+
+// Starts the oldest queued transaction
+static void start_head(bool backToBack)
+{
+	static uint8_t last_slave;
+
+	PSC3M5_SPI_Transaction *transaction = queue[queue_head];
+
+	PSC3M5_SPI_PortStart(transaction, backToBack && (transaction->slaveSelect != last_slave));
+	last_slave = transaction->slaveSelect;
+}
+
+// Sleeps until the oldest queued frame is done. The head is taken under the lock: the completion
+// interrupt advances it, and a pointer read outside could already be a finished and reused transaction.
+static void wait_oldest(void)
+{
+	PSC3M5_SPI_Transaction *oldest = NULL;
+	uint32_t state = PSC3M5_SPI_PortEnterCritical();
+
+	if(queue_count != 0)
+	{
+		oldest = queue[queue_head];
+	}
+
+	PSC3M5_SPI_PortExitCritical(state);
+
+	// Queue drained in the meantime - nothing to wait for
+	if(oldest != NULL)
+	{
+		PSC3M5_SPI_Wait(oldest);
+	}
+}
+
+// Sends one frame and sleeps until its response is in
+static void send_receive(PSC3M5_SPI_Transaction *transaction)
+{
+	PSC3M5_PROFILE_BEGIN(PSC3M5_PROFILE_SPI_FRAME);
+
+	// Queue full - sleep until the oldest frame is done
+	while(false == PSC3M5_SPI_Submit(transaction))
+	{
+		wait_oldest();
+	}
+
+	PSC3M5_SPI_Wait(transaction);
+
+	PSC3M5_PROFILE_END(PSC3M5_PROFILE_SPI_FRAME);
+}
+
+uint32_t PSC3M5_SPI_SendReceive(const uint8_t *txBuffer, uint8_t slaveSelect)
+{
+	PSC3M5_SPI_Transaction transaction = { .slaveSelect = slaveSelect, .txFrame = txBuffer };
+
+	send_receive(&transaction);
+
+    // Return sensor response
+    return transaction.response;
+}
+
+xensiv_rsp_frame_t PSC3M5_SPI_SendReceiveFrame(const uint8_t *txBuffer, uint8_t slaveSelect)
+{
+	PSC3M5_SPI_Transaction transaction = { .slaveSelect = slaveSelect, .txFrame = txBuffer };
+
+	send_receive(&transaction);
+
+	return transaction.frame;
+}
+
+bool PSC3M5_SPI_Submit(PSC3M5_SPI_Transaction *transaction)
+{
+	uint32_t state;
+
+	transaction->done = false;
+
+	state = PSC3M5_SPI_PortEnterCritical();
+
+	if(queue_count == SPI_QUEUE_LENGTH)
+	{
+		PSC3M5_SPI_PortExitCritical(state);
+		return false;
+	}
+
+	queue[(queue_head + queue_count) % SPI_QUEUE_LENGTH] = transaction;
+	queue_count++;
+
+	// Bus idle - start right away, otherwise the completion of the previous frame will
+	if(queue_count == 1)
+	{
+		start_head(false);
+	}
+
+	PSC3M5_SPI_PortExitCritical(state);
+
+	return true;
+}
+
+bool PSC3M5_SPI_SubmitPlan(PSC3M5_SPI_Transaction *plan, uint8_t count)
+{
+	uint32_t state;
+
+	if(count == 0)
+	{
+		return true;
+	}
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		plan[i].done = false;
+	}
+
+	state = PSC3M5_SPI_PortEnterCritical();
+
+	if((SPI_QUEUE_LENGTH - queue_count) < count)
+	{
+		PSC3M5_SPI_PortExitCritical(state);
+		return false;
+	}
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		queue[(queue_head + queue_count) % SPI_QUEUE_LENGTH] = &plan[i];
+		queue_count++;
+	}
+
+	// Bus idle - start the first one, the completions start the rest
+	if(queue_count == count)
+	{
+		start_head(false);
+	}
+
+	PSC3M5_SPI_PortExitCritical(state);
+
+	return true;
+}
+
+void PSC3M5_SPI_Wait(PSC3M5_SPI_Transaction *transaction)
+{
+	PSC3M5_PROFILE_BEGIN(PSC3M5_PROFILE_SPI_WAIT);
+
+	PSC3M5_SPI_PortWait(&transaction->done);
+
+	PSC3M5_PROFILE_END(PSC3M5_PROFILE_SPI_WAIT);
+}
+
+bool PSC3M5_SPI_IsBusy(void)
+{
+	return queue_count != 0;
+}
+
+void PSC3M5_SPI_RunPlan(PSC3M5_SPI_Transaction *plan, uint8_t count)
+{
+	if(count == 0)
+	{
+		return;
+	}
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		// Queue full - sleep until the oldest frame is done
+		while(false == PSC3M5_SPI_Submit(&plan[i]))
+		{
+			wait_oldest();
+		}
+	}
+
+	// Frames complete in order, the last one ends the plan
+	PSC3M5_SPI_Wait(&plan[count - 1]);
+}
+
+uint32_t PSC3M5_SPI_GetFrameCount(void)
+{
+	return frame_count;
+}
+
+void PSC3M5_SPI_GetFrameErrors(uint8_t slaveSelect, PSC3M5_SPI_FrameErrors *errors)
+{
+	uint8_t slave = slaveSelect % SPI_SLAVE_SELECT_COUNT;
+
+	errors->frames       = slave_frames[slave];
+	errors->crcErrors    = slave_crc_errors[slave];
+	errors->statusErrors = slave_status_errors[slave];
+}
+
+void PSC3M5_SPI_ClearFrameErrors(void)
+{
+	uint32_t state = PSC3M5_SPI_PortEnterCritical();
+
+	for(uint8_t slave = 0; slave < SPI_SLAVE_SELECT_COUNT; slave++)
+	{
+		slave_frames[slave]        = 0;
+		slave_crc_errors[slave]    = 0;
+		slave_status_errors[slave] = 0;
+	}
+
+	PSC3M5_SPI_PortExitCritical(state);
+}
+
+uint32_t PSC3M5_SPI_SetBitRate(uint32_t bitRateHz)
+{
+	// SCLK must not change mid-frame
+	while(PSC3M5_SPI_IsBusy())
+	{
+		wait_oldest();
+	}
+
+	return PSC3M5_SPI_PortSetBitRate(bitRateHz);
+}
+
+void PSC3M5_SPI_FrameDone(void)
+{
+	PSC3M5_SPI_Transaction *transaction = queue[queue_head];
+	uint8_t slave = transaction->slaveSelect % SPI_SLAVE_SELECT_COUNT;
+
+	transaction->timestamp = PSC3M5_SPI_PortNow();
+	frame_count++;
+
+	queue_head = (queue_head + 1) % SPI_QUEUE_LENGTH;
+	queue_count--;
+
+	// Keep the bus busy before handing out the response
+	if(queue_count != 0)
+	{
+		start_head(true);
+	}
+
+	// Assemble sensor response in a 32-bit word
+	transaction->response = ((uint32_t)transaction->rxFrame[0] << 24) | ((uint32_t)transaction->rxFrame[1] << 16) |
+							((uint32_t)transaction->rxFrame[2] << 8)  |  (uint32_t)transaction->rxFrame[3];
+
+	// Checked before anyone can see it - a frame failing the check never passes as data
+	transaction->frame = xensiv_rsp_decode(transaction->response, SPI_STATUS_ERROR_MASK);
+
+	slave_frames[slave]++;
+	if(transaction->frame.error & XENSIV_RSP_ERROR_CRC)
+	{
+		slave_crc_errors[slave]++;
+	}
+	if(transaction->frame.error & XENSIV_RSP_ERROR_STATUS)
+	{
+		slave_status_errors[slave]++;
+	}
+
+	transaction->done = true;
+
+	if(transaction->callback != NULL)
+	{
+		transaction->callback(transaction);
+	}
+}
+
+
+#ifndef PSC3M5_SPI_BACKEND_SIM
+
+// Port functions shared by the hardware transports - transport specific
+// PSC3M5_SPI_Init() and PSC3M5_SPI_PortStart() are in SPI_Port_*.c
+
+// SCB oversampling range of an SPI master with late MISO sampling
+#define SPI_OVS_MIN		(4U)
+#define SPI_OVS_MAX		(16U)
+
+static uint32_t port_idle_ticks;
+
+void PSC3M5_SPI_PortSelect(const PSC3M5_SPI_Transaction *transaction, bool slaveSwitch)
+{
+	static const cy_en_scb_spi_slave_select_t slave_select_line[SPI_SLAVE_SELECT_COUNT] =
+	{
+		CY_SCB_SPI_SLAVE_SELECT0, CY_SCB_SPI_SLAVE_SELECT1, CY_SCB_SPI_SLAVE_SELECT2, CY_SCB_SPI_SLAVE_SELECT3
+	};
+
+	// SPI is idle here
+	Cy_SCB_SPI_SetActiveSlaveSelect(SENSOR_SPI_HW, slave_select_line[transaction->slaveSelect % SPI_SLAVE_SELECT_COUNT]);
+
+	if(slaveSwitch)
+	{
+		// Cycle count rounded up, a few hundred ns at most
+		Cy_SysLib_DelayCycles((((SystemCoreClock / 1000000U) * SPI_SLAVE_SWITCH_DELAY_NS) + 999U) / 1000U);
+	}
+}
+
+void PSC3M5_SPI_PortWait(volatile bool *done)
+{
+	/* Sleep until done. Interrupts are masked around the check so that a
+	   completion between check and WFI still wakes the core. The caller's
+	   mask is restored at the end, a caller with interrupts masked keeps them so. */
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	while(false == *done)
+	{
+		// Pending interrupts run after the second timestamp, so their time counts as busy
+		uint32_t sleep_start = PSC3M5_Scheduler_PortNow();
+
+		__WFI();
+		port_idle_ticks += PSC3M5_Scheduler_PortNow() - sleep_start;
+		__enable_irq();
+		__disable_irq();
+	}
+	__set_PRIMASK(primask);
+}
+
+uint32_t PSC3M5_SPI_PortIdleTicks(void)
+{
+	return port_idle_ticks;
+}
+
+uint32_t PSC3M5_SPI_PortSetBitRate(uint32_t bitRateHz)
+{
+	// SCB clock as configured: DataRate times the configured oversampling
+	uint32_t scb_clock_hz = SPI_BIT_RATE_HZ * SENSOR_SPI_config.oversample;
+	uint32_t ovs = (scb_clock_hz + (bitRateHz / 2U)) / bitRateHz;
+
+	if(ovs < SPI_OVS_MIN)
+	{
+		ovs = SPI_OVS_MIN;
+	}
+	if(ovs > SPI_OVS_MAX)
+	{
+		ovs = SPI_OVS_MAX;
+	}
+
+	Cy_SCB_SPI_Disable(SENSOR_SPI_HW, &SENSOR_SPI_context);
+	SCB_CTRL(SENSOR_SPI_HW) = _CLR_SET_FLD32U(SCB_CTRL(SENSOR_SPI_HW), SCB_CTRL_OVS, ovs - 1UL);
+	Cy_SCB_SPI_Enable(SENSOR_SPI_HW);
+
+	return scb_clock_hz / ovs;
+}
+
+uint32_t PSC3M5_SPI_PortEnterCritical(void)
+{
+	return Cy_SysLib_EnterCriticalSection();
+}
+
+void PSC3M5_SPI_PortExitCritical(uint32_t state)
+{
+	Cy_SysLib_ExitCriticalSection(state);
+}
+
+uint32_t PSC3M5_SPI_PortNow(void)
+{
+	return PSC3M5_Scheduler_PortNow();
+}
+
+#endif /* PSC3M5_SPI_BACKEND_SIM */
+
+/* [] END OF FILE */
@@ -0,0 +1,230 @@
+#ifndef SRC_MCU_SPI_SPI_BACKEND_H_
+#define SRC_MCU_SPI_SPI_BACKEND_H_
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "xensiv_response.h"
+
+// SPI transports, one port file each. Selected at compile time with
+// DEFINES+=PSC3M5_SPI_TRANSPORT=PSC3M5_SPI_TRANSPORT_<name> in the Makefile,
+// only the selected port is compiled in.
+#define PSC3M5_SPI_TRANSPORT_BLOCKING	(1)		// SPI_Port_Blocking.c - FIFO polling, no interrupt
+#define PSC3M5_SPI_TRANSPORT_INTERRUPT	(2)		// SPI_Port_Interrupt.c - SCB transfer interrupt
+#define PSC3M5_SPI_TRANSPORT_DMA		(3)		// SPI_Port_DMA.c - TX/RX DMA channels, see src/MCU/DMA
+#define PSC3M5_SPI_TRANSPORT_SIM		(4)		// SPI_Backend_Sim.c - simulated sensors
+
+// Host (Linux) builds always run against the simulated sensors
+#if defined(__linux__)
+#undef PSC3M5_SPI_TRANSPORT
+#define PSC3M5_SPI_TRANSPORT	PSC3M5_SPI_TRANSPORT_SIM
+#endif
+
+#ifndef PSC3M5_SPI_TRANSPORT
+#define PSC3M5_SPI_TRANSPORT	PSC3M5_SPI_TRANSPORT_INTERRUPT
+#endif
+
+#if (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_SIM)
+#define PSC3M5_SPI_BACKEND_SIM
+#elif (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_BLOCKING) || (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_INTERRUPT)
+#include "cy_pdl.h"
+#include "cycfg.h"
+#elif (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_DMA)
+#include "cy_pdl.h"
+#include "cycfg.h"
+#include "src/MCU/DMA/DMA_SPI.h"
+#else
+#error "PSC3M5_SPI_TRANSPORT: unknown transport"
+#endif
+
+
+/* Assign SPI interrupt priority */
+#define SCB_SPI_INTR_PRIORITY  (3U)
+
+/* SCLK rate set as DataRate of SENSOR_SPI in the Device Configurator */
+#define SPI_BIT_RATE_HZ  (1000000U)
+
+/* Chip select high time inserted when back-to-back frames switch slave, 0 to disable.
+   Waited inline from the completion interrupt, keep it well below a microsecond */
+#define SPI_SLAVE_SWITCH_DELAY_NS  (500U)
+
+/* Slave select lines of the SCB, one sensor each */
+#define SPI_SLAVE_SELECT_COUNT  (4U)
+
+/* Maximum number of submitted, not yet completed transactions */
+#define SPI_QUEUE_LENGTH  (8U)
+
+/* Device status bits of a response counted as sensor errors, see the datasheet of the variant - none by default */
+#ifndef SPI_STATUS_ERROR_MASK
+#define SPI_STATUS_ERROR_MASK  (0x00U)
+#endif
+
+
+typedef struct PSC3M5_SPI_Transaction PSC3M5_SPI_Transaction;
+
+// Completion callback, called from interrupt context (from the caller with the blocking transport)
+typedef void (*PSC3M5_SPI_Callback)(PSC3M5_SPI_Transaction *transaction);
+
+// One 4-byte frame sent to one slave and its in-frame response
+struct PSC3M5_SPI_Transaction
+{
+	uint8_t slaveSelect;			// SPI slave select
+	const uint8_t *txFrame;			// 4-byte command frame, CRC included
+	uint8_t rxFrame[4];				// Raw response bytes, written by the transport
+	uint32_t response;				// Assembled 32-bit response, valid once done
+	xensiv_rsp_frame_t frame;		// Decoded and checked response, valid once done
+	PSC3M5_SPI_Callback callback;	// Optional completion callback, NULL if unused
+	void *context;					// User data for the callback
+	uint32_t timestamp;				// PSC3M5_SPI_PortNow() when the response came in
+	volatile bool done;				// Set by the engine when the response is in
+};
+
+// Response check counters of one slave select
+typedef struct
+{
+	uint32_t frames;			// Responses received
+	uint32_t crcErrors;			// Responses failing the CRC check
+	uint32_t statusErrors;		// Responses with a SPI_STATUS_ERROR_MASK status bit set
+} PSC3M5_SPI_FrameErrors;
+
+
+void PSC3M5_SPI_Init(void);
+uint32_t PSC3M5_SPI_SendReceive(const uint8_t *txBuffer, uint8_t slaveSelect);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_SendReceiveFrame
+ ***************************************************************************//**
+ * \brief  Sends one frame and waits for the response, like
+ *         PSC3M5_SPI_SendReceive(), but returns the decoded response.
+ * \param  txBuffer     4-byte command frame, CRC included.
+ * \param  slaveSelect  SPI slave select.
+ * \return Decoded response, its error field set if it failed the check.
+ ******************************************************************************/
+xensiv_rsp_frame_t PSC3M5_SPI_SendReceiveFrame(const uint8_t *txBuffer, uint8_t slaveSelect);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_Submit
+ ***************************************************************************//**
+ * \brief  Queues a transaction and returns immediately. Frames are sent in
+ *         submission order; the transaction must stay valid until done.
+ *         May be called from a completion callback.
+ * \param  transaction  Transaction to send.
+ * \return false if the queue is full, the transaction is not queued.
+ ******************************************************************************/
+bool PSC3M5_SPI_Submit(PSC3M5_SPI_Transaction *transaction);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_SubmitPlan
+ ***************************************************************************//**
+ * \brief  Queues a list of transactions back to back, all or none, and
+ *         returns immediately. Never waits, so it may be called from any
+ *         interrupt, e.g. a timer started after a SYNC pulse.
+ * \param  plan   Transactions, executed in order.
+ * \param  count  Number of transactions.
+ * \return false if the queue has no room for all of them, none is queued.
+ ******************************************************************************/
+bool PSC3M5_SPI_SubmitPlan(PSC3M5_SPI_Transaction *plan, uint8_t count);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_Wait
+ ***************************************************************************//**
+ * \brief  Sleeps until a submitted transaction is done.
+ * \param  transaction  Submitted transaction.
+ ******************************************************************************/
+void PSC3M5_SPI_Wait(PSC3M5_SPI_Transaction *transaction);
+
+// Returns true while frames are queued or on the wire
+bool PSC3M5_SPI_IsBusy(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_RunPlan
+ ***************************************************************************//**
+ * \brief  Sends a list of frames as one sequence and returns when all
+ *         responses are in. With the interrupt and DMA transports the
+ *         completion interrupt starts the next frame, so the caller sleeps
+ *         and wakes up once per plan.
+ * \param  plan   Transactions, executed in order.
+ * \param  count  Number of transactions.
+ ******************************************************************************/
+void PSC3M5_SPI_RunPlan(PSC3M5_SPI_Transaction *plan, uint8_t count);
+
+// Frames completed since start-up
+uint32_t PSC3M5_SPI_GetFrameCount(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_GetFrameErrors
+ ***************************************************************************//**
+ * \brief  Reads the response check counters of one slave select. Every
+ *         response is decoded and checked in the completion path, before
+ *         its transaction is done.
+ * \param  slaveSelect  SPI slave select.
+ * \param  errors       Counters since start-up or the last clear.
+ ******************************************************************************/
+void PSC3M5_SPI_GetFrameErrors(uint8_t slaveSelect, PSC3M5_SPI_FrameErrors *errors);
+
+// Clears the response check counters of all slave selects
+void PSC3M5_SPI_ClearFrameErrors(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_SPI_SetBitRate
+ ***************************************************************************//**
+ * \brief  Changes the SCLK rate. Waits for the queued frames first. On target
+ *         the SCB oversampling is changed, so the rate is the SCB clock
+ *         divided by 4 to 16 and the closest one is taken.
+ * \param  bitRateHz  Requested rate, SPI_BIT_RATE_HZ for the configured one.
+ * \return Rate applied, in Hz.
+ ******************************************************************************/
+uint32_t PSC3M5_SPI_SetBitRate(uint32_t bitRateHz);
+
+// Called by the transport when a frame has been received - from the SPI or
+// RX DMA interrupt, or from the blocking port itself
+void PSC3M5_SPI_FrameDone(void);
+
+// Backend port - selected transport in SPI_Port_*.c, simulation in SPI_Backend_Sim.c.
+// PortWait, critical sections and PortNow are shared by the hardware transports.
+void PSC3M5_SPI_PortStart(PSC3M5_SPI_Transaction *transaction, bool slaveSwitch);
+void PSC3M5_SPI_PortWait(volatile bool *done);
+uint32_t PSC3M5_SPI_PortEnterCritical(void);
+void PSC3M5_SPI_PortExitCritical(uint32_t state);
+uint32_t PSC3M5_SPI_PortNow(void);		// Scheduler timestamp clock - CPU cycles on target, ns in the simulation
+uint32_t PSC3M5_SPI_PortIdleTicks(void);	// PortNow ticks slept in PortWait, simulated wire time in the simulation
+uint32_t PSC3M5_SPI_PortSetBitRate(uint32_t bitRateHz);
+
+#ifndef PSC3M5_SPI_BACKEND_SIM
+// Activates the slave select of a transaction and the slave switch time, start of every hardware PortStart
+void PSC3M5_SPI_PortSelect(const PSC3M5_SPI_Transaction *transaction, bool slaveSwitch);
+
+// SPI context of the SCB, defined by the selected port
+extern cy_stc_scb_spi_context_t SENSOR_SPI_context;
+#endif
+
+#ifdef PSC3M5_SPI_BACKEND_SIM
+// Completes the frame on the simulated wire, returns false if the bus is idle
+bool PSC3M5_SPI_SimService(void);
+
+// Simulated sensor registers, for host-side setup and inspection
+void PSC3M5_SPI_SimSetRegister(uint8_t slaveSelect, uint8_t addr, uint16_t value);
+uint16_t PSC3M5_SPI_SimGetRegister(uint8_t slaveSelect, uint8_t addr);
+
+// Frames a simulated sensor ignores after power-on and soft reset, starting now
+#define PSC3M5_SPI_SIM_NEVER_BOOTS	(0xFFFFU)
+void PSC3M5_SPI_SimSetBootFrames(uint8_t slaveSelect, uint16_t frames);
+
+// Line noise: the next responses of a sensor arrive with one data bit flipped and fail the CRC check
+void PSC3M5_SPI_SimCorruptFrames(uint8_t slaveSelect, uint16_t frames);
+
+// Simulated SYNC edge: all sensors start capturing the predicted angle into the sync register
+void PSC3M5_SPI_SimSyncEdge(void);
+
+// Time from the SYNC edge until the sync register holds the new angle
+void PSC3M5_SPI_SimSetSyncLatency(uint8_t slaveSelect, uint16_t latencyUs);
+
+// Simulated time - advanced by frames, PSC3M5_Timer_Start() delays and PSC3M5_SPI_SimElapseUs()
+uint32_t PSC3M5_SPI_SimTimeUs(void);
+void PSC3M5_SPI_SimElapseUs(uint32_t us);
+
+// Rotating shaft: from now on the predicted angle of all sensors turns at this speed, 0 to stop
+void PSC3M5_SPI_SimSetShaftSpeed(int32_t lsbPerSecond);
+#endif
+
+
+#endif /* SRC_MCU_SPI_SPI_BACKEND_H_ */
@@ -0,0 +1,376 @@
+#include "SPI_Backend.h"
+
+#ifdef PSC3M5_SPI_BACKEND_SIM
+
+#include "src/Sensor/Interface/CRC8_SAE_J1850.h"
+#include "xensiv_nextframe.h"
+#include <stddef.h>
+
+
+// Simulated TLx49012 sensors: in-frame and next-frame protocol, register file only
+#define SIM_SLAVE_COUNT		SPI_SLAVE_SELECT_COUNT
+#define SIM_ADDR_COUNT		128
+
+// Boot: the sensor ignores SPI for a number of frames after power-on and soft
+// reset. The simulation has no time base, a frame stands for one poll.
+#define SIM_BOOT_FRAMES			4
+#define SIM_RESET_ADDR			0x02
+#define SIM_RESET_KEY			0x8E80
+#define SIM_RESET_KEY_MASK		0xFFFC
+
+static uint16_t sim_registers[SIM_SLAVE_COUNT][SIM_ADDR_COUNT];
+static uint8_t sim_status[SIM_SLAVE_COUNT];
+
+// Next-frame register pointer and access type, set by CMD_ADDR
+static uint16_t sim_pointer[SIM_SLAVE_COUNT];
+static uint8_t sim_access[SIM_SLAVE_COUNT];
+
+// Boot length and frames left until SPI is active
+static uint16_t sim_boot_frames[SIM_SLAVE_COUNT] = { SIM_BOOT_FRAMES, SIM_BOOT_FRAMES, SIM_BOOT_FRAMES, SIM_BOOT_FRAMES };
+static uint16_t sim_booting[SIM_SLAVE_COUNT];
+
+// Responses still to be corrupted on the wire, one data bit flipped after the CRC
+static uint16_t sim_corrupt[SIM_SLAVE_COUNT];
+
+// Sync capture: the sync register takes the predicted angle a latency after the
+// SYNC edge. readStatus is set once the register has been read, triggerStatus
+// while a capture is still running - a read in that window returns old data.
+#define SIM_FRAME_BITS			32
+#define SIM_SYNC_LATENCY_US		40
+#define SIM_SYNC_ADDR			0x0A
+#define SIM_ANGLE_PRED_ADDR		0x0C
+#define SIM_SYNC_READ_STATUS	0x0001
+#define SIM_SYNC_TRIG_STATUS	0x0002
+#define SIM_SYNC_ANGLE_MASK		0xFFFC
+
+static uint32_t sim_time_us;
+static uint32_t sim_time_ns;			// Below 1us, carried into sim_time_us
+static uint32_t sim_sync_edge_us;
+static uint16_t sim_sync_latency[SIM_SLAVE_COUNT] = { SIM_SYNC_LATENCY_US, SIM_SYNC_LATENCY_US, SIM_SYNC_LATENCY_US, SIM_SYNC_LATENCY_US };
+static bool sim_sync_capturing[SIM_SLAVE_COUNT];
+
+// Rotating shaft: the predicted angle of all sensors turns at one speed, each
+// sensor keeping its own offset. Speed 0 leaves the register as set.
+static int32_t sim_shaft_speed;			// LSB per second
+static uint32_t sim_shaft_origin_us;
+static uint32_t sim_shaft_origin_ns;
+static uint16_t sim_shaft_offset[SIM_SLAVE_COUNT];
+
+// Transaction on the simulated wire, and the wire time model: SCLK rate and
+// total time frames spent on the wire, slave switch time included
+static PSC3M5_SPI_Transaction *sim_in_flight;
+static bool sim_slave_switch;
+static uint32_t sim_bit_rate_hz = SPI_BIT_RATE_HZ;
+static uint32_t sim_wire_ns;
+
+
+static void sim_elapse_ns(uint32_t ns)
+{
+	sim_time_ns += ns;
+	sim_time_us += sim_time_ns / 1000U;
+	sim_time_ns %= 1000U;
+}
+
+static void sim_respond(uint8_t *rxFrame, uint8_t slave, uint8_t addr)
+{
+	// Response: status, register data, CRC
+	rxFrame[0] = sim_status[slave];
+	rxFrame[1] = (sim_registers[slave][addr] >> 8) & 0xFF;
+	rxFrame[2] = sim_registers[slave][addr] & 0xFF;
+	rxFrame[3] = CalcCRC(rxFrame, 3);
+}
+
+// Shaft angle seen by a sensor at a simulated time - to the ns, the frame timestamps are in ns
+static uint16_t sim_shaft_angle(uint8_t slave, uint32_t timeUs, uint32_t timeNs)
+{
+	int64_t elapsed_ns = ((int64_t)(uint32_t)(timeUs - sim_shaft_origin_us) * 1000) + timeNs - sim_shaft_origin_ns;
+
+	// Whole seconds and the rest apart, the product stays within 64 bits
+	int64_t turned = ((int64_t)sim_shaft_speed * (elapsed_ns / 1000000000)) +
+					 (((int64_t)sim_shaft_speed * (elapsed_ns % 1000000000)) / 1000000000);
+
+	return (uint16_t)(sim_shaft_offset[slave] + (uint16_t)turned);
+}
+
+// Brings the sync register up to the current simulated time
+static void sim_sync_update(uint8_t slave)
+{
+	uint16_t *sync = &sim_registers[slave][SIM_SYNC_ADDR];
+
+	if(false == sim_sync_capturing[slave])
+	{
+		return;
+	}
+
+	if((sim_time_us - sim_sync_edge_us) >= sim_sync_latency[slave])
+	{
+		// Angle latched at the SYNC edge
+		if(sim_shaft_speed != 0)
+		{
+			*sync = sim_shaft_angle(slave, sim_sync_edge_us, 0) & SIM_SYNC_ANGLE_MASK;
+		}
+		else
+		{
+			*sync = sim_registers[slave][SIM_ANGLE_PRED_ADDR] & SIM_SYNC_ANGLE_MASK;
+		}
+		sim_sync_capturing[slave] = false;
+	}
+	else
+	{
+		*sync |= SIM_SYNC_TRIG_STATUS;
+	}
+}
+
+static void sim_next_frame(const uint8_t *txFrame, uint8_t *rxFrame, uint8_t slave)
+{
+	uint8_t addr = sim_pointer[slave] % SIM_ADDR_COUNT;
+
+	// Whatever the frame, MISO carries the register addressed so far
+	sim_respond(rxFrame, slave, addr);
+
+	if(txFrame[0] == XENSIV_NXF_CMD_ADDR)
+	{
+		sim_pointer[slave] = (((uint16_t)txFrame[1] << 6) | (txFrame[2] >> 2)) & XENSIV_NXF_ADDR_MASK;
+		sim_access[slave]  = txFrame[2] & 0x03;
+		return;
+	}
+
+	if(sim_access[slave] == XENSIV_NXF_AC_READ_INC)
+	{
+		if(txFrame[2] == 0xFF)
+		{
+			sim_status[slave] = 0;
+		}
+	}
+	else
+	{
+		sim_registers[slave][addr] = ((uint16_t)txFrame[1] << 8) | txFrame[2];
+	}
+
+	if(sim_access[slave] != XENSIV_NXF_AC_WRITE_CONT)
+	{
+		sim_pointer[slave] = (sim_pointer[slave] + 1) & XENSIV_NXF_ADDR_MASK;
+	}
+}
+
+static void sim_transfer(const uint8_t *txFrame, uint8_t *rxFrame, uint8_t slaveSelect)
+{
+	uint8_t slave = slaveSelect % SIM_SLAVE_COUNT;
+	uint8_t addr  = (txFrame[0] >> 1) & 0x7F;
+
+	// SPI not active yet - frame ignored, MISO low
+	if(sim_booting[slave] != 0)
+	{
+		if(sim_booting[slave] != PSC3M5_SPI_SIM_NEVER_BOOTS)
+		{
+			sim_booting[slave]--;
+		}
+		rxFrame[0] = rxFrame[1] = rxFrame[2] = rxFrame[3] = 0;
+		return;
+	}
+
+	if(sim_shaft_speed != 0)
+	{
+		sim_registers[slave][SIM_ANGLE_PRED_ADDR] = sim_shaft_angle(slave, sim_time_us, sim_time_ns);
+	}
+
+	if((txFrame[0] == XENSIV_NXF_CMD_ADDR) || (txFrame[0] == XENSIV_NXF_CMD_DATA_ADDR))
+	{
+		sim_next_frame(txFrame, rxFrame, slave);
+		return;
+	}
+
+	if(txFrame[0] & 1)
+	{
+		sim_registers[slave][addr] = ((uint16_t)txFrame[1] << 8) | txFrame[2];
+	}
+	else if(addr == SIM_SYNC_ADDR)
+	{
+		sim_sync_update(slave);
+	}
+
+	sim_respond(rxFrame, slave, addr);
+
+	if(!(txFrame[0] & 1) && (addr == SIM_SYNC_ADDR))
+	{
+		sim_registers[slave][addr] |= SIM_SYNC_READ_STATUS;
+	}
+
+	// Soft reset - registers kept, SPI down until booted
+	if((txFrame[0] & 1) && (addr == SIM_RESET_ADDR) && ((sim_registers[slave][addr] & SIM_RESET_KEY_MASK) == SIM_RESET_KEY))
+	{
+		sim_booting[slave] = sim_boot_frames[slave];
+	}
+
+	if(!(txFrame[0] & 1) && (txFrame[2] == 0xFF))
+	{
+		sim_status[slave] = 0;
+	}
+}
+
+void PSC3M5_SPI_Init(void)
+{
+	sim_in_flight = NULL;
+
+	for(uint8_t slave = 0; slave < SIM_SLAVE_COUNT; slave++)
+	{
+		sim_status[slave]  = 0;
+		sim_pointer[slave] = 0;
+		sim_access[slave]  = XENSIV_NXF_AC_READ_INC;
+		sim_booting[slave] = sim_boot_frames[slave];
+		sim_sync_capturing[slave] = false;
+
+		for(uint8_t addr = 0; addr < SIM_ADDR_COUNT; addr++)
+		{
+			sim_registers[slave][addr] = 0;
+		}
+	}
+}
+
+void PSC3M5_SPI_PortStart(PSC3M5_SPI_Transaction *transaction, bool slaveSwitch)
+{
+	// The frame stays on the simulated wire until PSC3M5_SPI_SimService()
+	sim_in_flight    = transaction;
+	sim_slave_switch = slaveSwitch;
+}
+
+void PSC3M5_SPI_PortWait(volatile bool *done)
+{
+	// No interrupts on the host - run the wire until done
+	while(false == *done)
+	{
+		if(false == PSC3M5_SPI_SimService())
+		{
+			break;
+		}
+	}
+}
+
+uint32_t PSC3M5_SPI_PortEnterCritical(void)
+{
+	return 0;
+}
+
+void PSC3M5_SPI_PortExitCritical(uint32_t state)
+{
+	(void)state;
+}
+
+uint32_t PSC3M5_SPI_PortNow(void)
+{
+	// ns, same unit as the host scheduler clock
+	return (sim_time_us * 1000U) + sim_time_ns;
+}
+
+uint32_t PSC3M5_SPI_PortIdleTicks(void)
+{
+	// The host CPU never waits for the wire, it is modelled instead
+	return sim_wire_ns;
+}
+
+uint32_t PSC3M5_SPI_PortSetBitRate(uint32_t bitRateHz)
+{
+	sim_bit_rate_hz = (bitRateHz != 0) ? bitRateHz : SPI_BIT_RATE_HZ;
+
+	return sim_bit_rate_hz;
+}
+
+bool PSC3M5_SPI_SimService(void)
+{
+	PSC3M5_SPI_Transaction *transaction = sim_in_flight;
+	uint32_t wire_ns = (uint32_t)(((uint64_t)SIM_FRAME_BITS * 1000000000U) / sim_bit_rate_hz);
+
+	if(transaction == NULL)
+	{
+		return false;
+	}
+
+	// Slave switch time before the frame - the sensor sees the frame after it
+	if(sim_slave_switch)
+	{
+		sim_elapse_ns(SPI_SLAVE_SWITCH_DELAY_NS);
+		sim_wire_ns += SPI_SLAVE_SWITCH_DELAY_NS;
+	}
+
+	sim_in_flight = NULL;
+	sim_transfer(transaction->txFrame, transaction->rxFrame, transaction->slaveSelect);
+	if(sim_corrupt[transaction->slaveSelect % SIM_SLAVE_COUNT] != 0)
+	{
+		sim_corrupt[transaction->slaveSelect % SIM_SLAVE_COUNT]--;
+		transaction->rxFrame[2] ^= 0x01;
+	}
+	sim_elapse_ns(wire_ns);
+	sim_wire_ns  += wire_ns;
+
+	// Same path as the SPI interrupt
+	PSC3M5_SPI_FrameDone();
+
+	return true;
+}
+
+void PSC3M5_SPI_SimSetRegister(uint8_t slaveSelect, uint8_t addr, uint16_t value)
+{
+	sim_registers[slaveSelect % SIM_SLAVE_COUNT][addr & 0x7F] = value;
+}
+
+uint16_t PSC3M5_SPI_SimGetRegister(uint8_t slaveSelect, uint8_t addr)
+{
+	return sim_registers[slaveSelect % SIM_SLAVE_COUNT][addr & 0x7F];
+}
+
+void PSC3M5_SPI_SimSetBootFrames(uint8_t slaveSelect, uint16_t frames)
+{
+	sim_boot_frames[slaveSelect % SIM_SLAVE_COUNT] = frames;
+	sim_booting[slaveSelect % SIM_SLAVE_COUNT]     = frames;
+}
+
+void PSC3M5_SPI_SimCorruptFrames(uint8_t slaveSelect, uint16_t frames)
+{
+	sim_corrupt[slaveSelect % SIM_SLAVE_COUNT] = frames;
+}
+
+void PSC3M5_SPI_SimSyncEdge(void)
+{
+	sim_sync_edge_us = sim_time_us;
+
+	for(uint8_t slave = 0; slave < SIM_SLAVE_COUNT; slave++)
+	{
+		sim_sync_capturing[slave] = true;
+	}
+}
+
+void PSC3M5_SPI_SimSetSyncLatency(uint8_t slaveSelect, uint16_t latencyUs)
+{
+	sim_sync_latency[slaveSelect % SIM_SLAVE_COUNT] = latencyUs;
+}
+
+uint32_t PSC3M5_SPI_SimTimeUs(void)
+{
+	return sim_time_us;
+}
+
+void PSC3M5_SPI_SimElapseUs(uint32_t us)
+{
+	sim_time_us += us;
+}
+
+void PSC3M5_SPI_SimSetShaftSpeed(int32_t lsbPerSecond)
+{
+	// Restart the motion from the angles reached so far
+	for(uint8_t slave = 0; slave < SIM_SLAVE_COUNT; slave++)
+	{
+		if(sim_shaft_speed != 0)
+		{
+			sim_registers[slave][SIM_ANGLE_PRED_ADDR] = sim_shaft_angle(slave, sim_time_us, sim_time_ns);
+		}
+		sim_shaft_offset[slave] = sim_registers[slave][SIM_ANGLE_PRED_ADDR];
+	}
+
+	sim_shaft_origin_us = sim_time_us;
+	sim_shaft_origin_ns = sim_time_ns;
+	sim_shaft_speed     = lsbPerSecond;
+}
+
+#endif /* PSC3M5_SPI_BACKEND_SIM */
+
+/* [] END OF FILE */
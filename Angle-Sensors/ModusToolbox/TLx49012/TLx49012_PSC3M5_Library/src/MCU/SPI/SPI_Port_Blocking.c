@@ -0,0 +1,58 @@
+#include "SPI_Backend.h"
+
+#if (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_BLOCKING)
+
+/* No SPI interrupt: every frame is sent and received by polling the SCB FIFOs
+   inside PSC3M5_SPI_PortStart(), which completes it before returning. The queue
+   therefore never holds more than one frame, or one plan of
+   PSC3M5_SPI_SubmitPlan(), and completion callbacks run in the context of the
+   caller of PSC3M5_SPI_Submit(). */
+
+
+// SPI context, used in SPI High-level protocol
+cy_stc_scb_spi_context_t SENSOR_SPI_context;
+
+
+void PSC3M5_SPI_Init(void)
+{
+    cy_en_scb_spi_status_t result;
+
+    // Configure the SPI block
+    result = Cy_SCB_SPI_Init(SENSOR_SPI_HW, &SENSOR_SPI_config, &SENSOR_SPI_context);
+    if( result != CY_SCB_SPI_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    // Set active slave select to line 0
+    Cy_SCB_SPI_SetActiveSlaveSelect(SENSOR_SPI_HW, CY_SCB_SPI_SLAVE_SELECT0);
+
+    // Enable the SPI Master block
+    Cy_SCB_SPI_Enable(SENSOR_SPI_HW);
+}
+
+void PSC3M5_SPI_PortStart(PSC3M5_SPI_Transaction *transaction, bool slaveSwitch)
+{
+	PSC3M5_SPI_PortSelect(transaction, slaveSwitch);
+
+	// Leftovers of an aborted frame would shift the response
+	Cy_SCB_SPI_ClearRxFifo(SENSOR_SPI_HW);
+
+	// The 4-byte frame fits the FIFOs, one byte is received per byte sent
+	Cy_SCB_SPI_WriteArrayBlocking(SENSOR_SPI_HW, (void *)transaction->txFrame, sizeof(transaction->rxFrame));
+
+	while(Cy_SCB_SPI_GetNumInRxFifo(SENSOR_SPI_HW) < sizeof(transaction->rxFrame))
+	{
+	}
+
+	if(sizeof(transaction->rxFrame) != Cy_SCB_SPI_ReadArray(SENSOR_SPI_HW, transaction->rxFrame, sizeof(transaction->rxFrame)))
+	{
+		CY_ASSERT(0);
+	}
+
+	PSC3M5_SPI_FrameDone();
+}
+
+#endif /* PSC3M5_SPI_TRANSPORT_BLOCKING */
+
+/* [] END OF FILE */
@@ -0,0 +1,58 @@
+#include "SPI_Backend.h"
+
+#if (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_DMA)
+
+#include "cy_dma.h"
+#include "cy_scb_spi.h"
+
+
+// SPI context, used in SPI High-level protocol
+cy_stc_scb_spi_context_t SENSOR_SPI_context;
+
+
+void PSC3M5_SPI_Init(void)
+{
+	uint32_t status = 0;
+    cy_en_scb_spi_status_t result;
+
+    // Configure the SPI block
+    result = Cy_SCB_SPI_Init(SENSOR_SPI_HW, &SENSOR_SPI_config, &SENSOR_SPI_context);
+    if( result != CY_SCB_SPI_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+
+    // Set active slave select to line 0
+    Cy_SCB_SPI_SetActiveSlaveSelect(SENSOR_SPI_HW, CY_SCB_SPI_SLAVE_SELECT0);
+
+    // Enable the SPI Master block
+    Cy_SCB_SPI_Enable(SENSOR_SPI_HW);
+
+	// Configure DMA - buffer addresses are set per frame by start_dma_frame()
+	status = configure_rx_dma(NULL);
+	if (INIT_FAILURE == status)
+    {
+        /* NOTE: This function will block the CPU forever */
+       CY_ASSERT(0);
+    }
+
+	status = configure_tx_dma(NULL);
+	if (INIT_FAILURE == status)
+    {
+        /* NOTE: This function will block the CPU forever */
+       CY_ASSERT(0);
+    }
+
+}
+
+void PSC3M5_SPI_PortStart(PSC3M5_SPI_Transaction *transaction, bool slaveSwitch)
+{
+	PSC3M5_SPI_PortSelect(transaction, slaveSwitch);
+
+	// Completion is reported by rx_dma_complete()
+	start_dma_frame(transaction->txFrame, transaction->rxFrame);
+}
+
+#endif /* PSC3M5_SPI_TRANSPORT_DMA */
+
+/* [] END OF FILE */
@@ -1,5 +1,6 @@
 #include "SPI_Backend.h"
 
+#if (PSC3M5_SPI_TRANSPORT == PSC3M5_SPI_TRANSPORT_INTERRUPT)
 
 // SPI context, used in SPI High-level protocol
 cy_stc_scb_spi_context_t SENSOR_SPI_context;
@@ -11,15 +12,21 @@ const cy_stc_sysint_t SENSOR_SPI_IRQ_cfg =
 	    .intrPriority = SCB_SPI_INTR_PRIORITY
     };
 
-// Array for storing the last sensor response
-static uint8_t sensor_response[4] = {};
-
 
 void PSC3M5_SPI_Interrupt(void)
 {
     Cy_SCB_SPI_Interrupt(SENSOR_SPI_HW, &SENSOR_SPI_context);
 }
 
+// SPI driver event, called from PSC3M5_SPI_Interrupt()
+static void PSC3M5_SPI_Event(uint32_t event)
+{
+	if(0UL != (CY_SCB_SPI_TRANSFER_CMPLT_EVENT & event))
+	{
+		PSC3M5_SPI_FrameDone();
+	}
+}
+
 
 void PSC3M5_SPI_Init(void)
 {
@@ -32,18 +39,21 @@ void PSC3M5_SPI_Init(void)
     {
         CY_ASSERT(0);
     }
-    
+
     // Set active slave select to line 0
     Cy_SCB_SPI_SetActiveSlaveSelect(SENSOR_SPI_HW, CY_SCB_SPI_SLAVE_SELECT0);
 
     // Hook interrupt service routine and enable interrupt
     sysSPIstatus = Cy_SysInt_Init(&SENSOR_SPI_IRQ_cfg, &PSC3M5_SPI_Interrupt);
-    
+
     if(sysSPIstatus != CY_SYSINT_SUCCESS)
     {
         CY_ASSERT(0);
     }
-     
+
+    // Completed transfers start the next queued one from the interrupt
+    Cy_SCB_SPI_RegisterCallback(SENSOR_SPI_HW, &PSC3M5_SPI_Event, &SENSOR_SPI_context);
+
     // Enable interrupt in NVIC
     NVIC_EnableIRQ(SENSOR_SPI_IRQ);
 
@@ -51,21 +61,18 @@ void PSC3M5_SPI_Init(void)
     Cy_SCB_SPI_Enable(SENSOR_SPI_HW);
 }
 
-uint32_t PSC3M5_SPI_SendReceive(uint8_t *txBuffer)
+void PSC3M5_SPI_PortStart(PSC3M5_SPI_Transaction *transaction, bool slaveSwitch)
 {
-    // Initiate SPI Master write transaction
-    Cy_SCB_SPI_Transfer(SENSOR_SPI_HW, txBuffer, sensor_response, sizeof(txBuffer), &SENSOR_SPI_context);
-
-    // Blocking wait for transfer completion
-    while (0UL != (CY_SCB_SPI_TRANSFER_ACTIVE & Cy_SCB_SPI_GetTransferStatus(SENSOR_SPI_HW, &SENSOR_SPI_context)));
-    
-    // Assemble sensor response in a 32-bit word
-    uint32_t response = (sensor_response[0] << 24) | (sensor_response[1] << 16) | (sensor_response[2] << 8) | sensor_response[3]; 
-    
-    // Return sensor response
-    return response;
-}
+	PSC3M5_SPI_PortSelect(transaction, slaveSwitch);
 
-/* [] END OF FILE */
+    // Initiate SPI Master transaction, completion is reported by PSC3M5_SPI_Event()
+    if(CY_SCB_SPI_SUCCESS != Cy_SCB_SPI_Transfer(SENSOR_SPI_HW, (void *)transaction->txFrame, transaction->rxFrame,
+    											 sizeof(transaction->rxFrame), &SENSOR_SPI_context))
+    {
+        CY_ASSERT(0);
+    }
+}
 
+#endif /* PSC3M5_SPI_TRANSPORT_INTERRUPT */
 
+/* [] END OF FILE */
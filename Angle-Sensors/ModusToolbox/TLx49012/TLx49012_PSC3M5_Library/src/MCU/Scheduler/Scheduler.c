@@ -0,0 +1,132 @@
+#include "Scheduler.h"
+
+
+static PSC3M5_Scheduler_Stats stats;
+static uint32_t last_start;
+
+
+void PSC3M5_Scheduler_Init(uint32_t rateHz)
+{
+	stats = (PSC3M5_Scheduler_Stats){ 0 };
+
+	stats.rateHz      = rateHz;
+	stats.clockHz     = PSC3M5_Scheduler_PortClockHz();
+	stats.periodTicks = stats.clockHz / rateHz;
+
+	PSC3M5_Scheduler_PortStart(rateHz);
+}
+
+uint32_t PSC3M5_Scheduler_WaitTick(void)
+{
+	uint32_t periods = PSC3M5_Scheduler_PortWait();
+	uint32_t now     = PSC3M5_Scheduler_PortNow();
+
+	if(periods > 1)
+	{
+		stats.overruns += periods - 1;
+	}
+
+	// Start-to-start time against the nominal period(s), unsigned wrap-safe
+	if(stats.cycles != 0)
+	{
+		uint32_t elapsed  = now - last_start;
+		uint32_t expected = stats.periodTicks * periods;
+
+		stats.jitterLastTicks = (elapsed > expected) ? (elapsed - expected) : (expected - elapsed);
+		stats.jitterSumTicks += stats.jitterLastTicks;
+
+		if(stats.jitterLastTicks > stats.jitterMaxTicks)
+		{
+			stats.jitterMaxTicks = stats.jitterLastTicks;
+		}
+	}
+
+	last_start = now;
+	stats.cycles++;
+
+	return periods;
+}
+
+const PSC3M5_Scheduler_Stats * PSC3M5_Scheduler_GetStats(void)
+{
+	return &stats;
+}
+
+uint32_t PSC3M5_Scheduler_Now(void)
+{
+	return PSC3M5_Scheduler_PortNow();
+}
+
+
+#ifndef PSC3M5_SCHEDULER_HOST
+
+#include "cy_pdl.h"
+#include "cy_systick.h"
+
+// SysTick reload is 24-bit; slower rates divide a faster tick
+#define SYSTICK_MAX_RELOAD		(0xFFFFFFUL)
+
+static volatile uint32_t ticks_pending;
+static uint32_t tick_divider;
+static uint32_t tick_count;
+
+
+static void scheduler_tick(void)
+{
+	if(++tick_count >= tick_divider)
+	{
+		tick_count = 0;
+		ticks_pending++;
+	}
+}
+
+void PSC3M5_Scheduler_PortStart(uint32_t rateHz)
+{
+	uint32_t cycles = SystemCoreClock / rateHz;
+
+	// DWT cycle counter for timestamps
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	tick_divider  = (cycles + SYSTICK_MAX_RELOAD - 1) / SYSTICK_MAX_RELOAD;
+	tick_count    = 0;
+	ticks_pending = 0;
+
+	Cy_SysTick_Init(CY_SYSTICK_CLOCK_SOURCE_CLK_CPU, (cycles / tick_divider) - 1);
+	Cy_SysTick_SetCallback(0, &scheduler_tick);
+}
+
+uint32_t PSC3M5_Scheduler_PortWait(void)
+{
+	uint32_t periods;
+
+	/* Sleep until the next tick. Interrupts are masked around the check so
+	   that a tick between check and WFI still wakes the core. */
+	__disable_irq();
+	while(ticks_pending == 0)
+	{
+		__WFI();
+		__enable_irq();
+		__disable_irq();
+	}
+	periods = ticks_pending;
+	ticks_pending = 0;
+	__enable_irq();
+
+	return periods;
+}
+
+uint32_t PSC3M5_Scheduler_PortNow(void)
+{
+	return DWT->CYCCNT;
+}
+
+uint32_t PSC3M5_Scheduler_PortClockHz(void)
+{
+	return SystemCoreClock;
+}
+
+#endif /* PSC3M5_SCHEDULER_HOST */
+
+/* [] END OF FILE */
@@ -0,0 +1,59 @@
+#ifndef SRC_MCU_SCHEDULER_SCHEDULER_H_
+#define SRC_MCU_SCHEDULER_SCHEDULER_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+// Host (Linux) builds use the timerfd port in Scheduler_Host.c
+#if defined(__linux__)
+#define PSC3M5_SCHEDULER_HOST
+#endif
+
+
+// Period statistics, in timestamp clock ticks (CPU cycles on target, ns on host)
+typedef struct
+{
+	uint32_t rateHz;			// Configured acquisition rate
+	uint32_t clockHz;			// Timestamp clock frequency
+	uint32_t periodTicks;		// Nominal period
+	uint32_t cycles;			// Periods executed
+	uint32_t overruns;			// Periods missed because the previous one ran too long
+	uint32_t jitterLastTicks;	// |actual - nominal| start-to-start time of the last period
+	uint32_t jitterMaxTicks;	// Worst jitter since PSC3M5_Scheduler_Init()
+	uint64_t jitterSumTicks;	// For the average: jitterSumTicks / (cycles - 1)
+} PSC3M5_Scheduler_Stats;
+
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Scheduler_Init
+ ***************************************************************************//**
+ * \brief  Starts the periodic acquisition timer and clears the statistics.
+ * \param  rateHz  Acquisition rate, 1Hz up to the kHz range.
+ ******************************************************************************/
+void PSC3M5_Scheduler_Init(uint32_t rateHz);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Scheduler_WaitTick
+ ***************************************************************************//**
+ * \brief  Sleeps until the next period starts and updates the statistics.
+ *         Periods that elapsed while the caller was busy are counted as
+ *         overruns and skipped, so the loop never runs to catch up.
+ * \return Number of periods elapsed since the previous call, 1 if on time.
+ ******************************************************************************/
+uint32_t PSC3M5_Scheduler_WaitTick(void);
+
+// Returns the period statistics
+const PSC3M5_Scheduler_Stats * PSC3M5_Scheduler_GetStats(void);
+
+// Returns the current timestamp, in PSC3M5_Scheduler_Stats clock ticks
+uint32_t PSC3M5_Scheduler_Now(void);
+
+// Scheduler port - SysTick/DWT in Scheduler.c, timerfd in Scheduler_Host.c
+void PSC3M5_Scheduler_PortStart(uint32_t rateHz);
+uint32_t PSC3M5_Scheduler_PortWait(void);
+uint32_t PSC3M5_Scheduler_PortNow(void);
+uint32_t PSC3M5_Scheduler_PortClockHz(void);
+
+
+#endif /* SRC_MCU_SCHEDULER_SCHEDULER_H_ */
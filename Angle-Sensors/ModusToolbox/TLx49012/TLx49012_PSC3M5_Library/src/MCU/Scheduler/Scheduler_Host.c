@@ -0,0 +1,70 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE			// timerfd, clock_gettime - unless the build defines it already
+#endif
+
+#include "Scheduler.h"
+
+#ifdef PSC3M5_SCHEDULER_HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/timerfd.h>
+
+
+static int timer_fd = -1;
+
+
+void PSC3M5_Scheduler_PortStart(uint32_t rateHz)
+{
+	uint64_t period_ns = 1000000000ULL / rateHz;
+	struct itimerspec spec;
+
+	spec.it_interval.tv_sec  = (time_t)(period_ns / 1000000000ULL);
+	spec.it_interval.tv_nsec = (long)(period_ns % 1000000000ULL);
+	spec.it_value            = spec.it_interval;
+
+	if(timer_fd < 0)
+	{
+		timer_fd = timerfd_create(CLOCK_MONOTONIC, 0);
+	}
+
+	if((timer_fd < 0) || (timerfd_settime(timer_fd, 0, &spec, NULL) != 0))
+	{
+		perror("timerfd");
+		exit(EXIT_FAILURE);
+	}
+}
+
+uint32_t PSC3M5_Scheduler_PortWait(void)
+{
+	uint64_t expirations = 0;
+
+	// Blocks until the next expiration, returns how many elapsed since the last read
+	if(read(timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+	{
+		perror("timerfd read");
+		exit(EXIT_FAILURE);
+	}
+
+	return (uint32_t)expirations;
+}
+
+uint32_t PSC3M5_Scheduler_PortNow(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+}
+
+uint32_t PSC3M5_Scheduler_PortClockHz(void)
+{
+	return 1000000000UL;
+}
+
+#endif /* PSC3M5_SCHEDULER_HOST */
+
+/* [] END OF FILE */
@@ -0,0 +1,106 @@
+#include "Timer.h"
+#include "src/MCU/SPI/SPI_Backend.h"
+#include <stddef.h>
+
+
+#if defined(PSC3M5_SPI_BACKEND_SIM)
+
+void PSC3M5_Timer_Init(void)
+{
+}
+
+bool PSC3M5_Timer_Start(uint16_t delayUs, PSC3M5_Timer_Callback callback, void *context)
+{
+	// Simulated time only moves on request - the delay passes at once
+	PSC3M5_SPI_SimElapseUs(delayUs);
+	callback(context);
+
+	return true;
+}
+
+#elif defined(DELAY_TIMER_HW) && (PSC3M5_SPI_TRANSPORT != PSC3M5_SPI_TRANSPORT_BLOCKING)
+
+static PSC3M5_Timer_Callback timer_callback;
+static void *timer_context;
+static volatile bool timer_running;
+
+// Interrupt configuration structure
+const cy_stc_sysint_t DELAY_TIMER_IRQ_cfg =
+    {
+	    .intrSrc      = DELAY_TIMER_IRQ,
+	    .intrPriority = DELAY_TIMER_INTR_PRIORITY
+    };
+
+
+// Terminal count - the one-shot counter has stopped
+static void PSC3M5_Timer_Interrupt(void)
+{
+	Cy_TCPWM_ClearInterrupt(DELAY_TIMER_HW, DELAY_TIMER_NUM, CY_TCPWM_INT_ON_TC);
+
+	timer_running = false;
+	timer_callback(timer_context);
+}
+
+void PSC3M5_Timer_Init(void)
+{
+	if(Cy_TCPWM_Counter_Init(DELAY_TIMER_HW, DELAY_TIMER_NUM, &DELAY_TIMER_config) != CY_TCPWM_SUCCESS)
+	{
+		CY_ASSERT(0);
+	}
+	Cy_TCPWM_Counter_Enable(DELAY_TIMER_HW, DELAY_TIMER_NUM);
+	Cy_TCPWM_SetInterruptMask(DELAY_TIMER_HW, DELAY_TIMER_NUM, CY_TCPWM_INT_ON_TC);
+
+	// Hook interrupt service routine and enable interrupt
+	if(Cy_SysInt_Init(&DELAY_TIMER_IRQ_cfg, &PSC3M5_Timer_Interrupt) != CY_SYSINT_SUCCESS)
+	{
+		CY_ASSERT(0);
+	}
+	NVIC_EnableIRQ(DELAY_TIMER_IRQ);
+}
+
+bool PSC3M5_Timer_Start(uint16_t delayUs, PSC3M5_Timer_Callback callback, void *context)
+{
+	if(timer_running)
+	{
+		return false;
+	}
+
+	if(delayUs == 0)
+	{
+		callback(context);
+		return true;
+	}
+
+	timer_callback = callback;
+	timer_context  = context;
+	timer_running  = true;
+
+	// 1MHz clock, counting up from 0 - terminal count after delayUs, then the counter stops
+	Cy_TCPWM_Counter_SetCounter(DELAY_TIMER_HW, DELAY_TIMER_NUM, 0);
+	Cy_TCPWM_Counter_SetPeriod(DELAY_TIMER_HW, DELAY_TIMER_NUM, delayUs);
+	Cy_TCPWM_TriggerStart_Single(DELAY_TIMER_HW, DELAY_TIMER_NUM);
+
+	return true;
+}
+
+#else
+
+void PSC3M5_Timer_Init(void)
+{
+}
+
+bool PSC3M5_Timer_Start(uint16_t delayUs, PSC3M5_Timer_Callback callback, void *context)
+{
+	// No DELAY_TIMER in the device configuration, or blocking transport - wait in the caller
+	if(delayUs != 0)
+	{
+		Cy_SysLib_DelayUs(delayUs);
+	}
+	callback(context);
+
+	return true;
+}
+
+#endif
+
+/* [] END OF FILE */
@@ -0,0 +1,38 @@
+#ifndef SRC_MCU_TIMER_TIMER_H_
+#define SRC_MCU_TIMER_TIMER_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+
+// One-shot delay timer, e.g. from the SYNC pulse to the sync read. On target it is the TCPWM
+// counter with the alias DELAY_TIMER in the device configuration: one-shot run mode, 1MHz
+// counter clock, counting up. The SPI simulation advances its own clock instead. Without
+// DELAY_TIMER, and with the blocking transport, the delay is waited out in the caller.
+
+/* Assign delay timer interrupt priority */
+#define DELAY_TIMER_INTR_PRIORITY  (3U)
+
+// Called once the delay has passed - from the timer interrupt, or from the caller of PSC3M5_Timer_Start()
+typedef void (*PSC3M5_Timer_Callback)(void *context);
+
+
+// Sets up the TCPWM counter and its interrupt, if any
+void PSC3M5_Timer_Init(void);
+
+/*******************************************************************************
+ * Function Name: PSC3M5_Timer_Start
+ ***************************************************************************//**
+ * \brief  Calls back once after a delay. With DELAY_TIMER the call returns at
+ *         once and the callback runs in the timer interrupt; otherwise the
+ *         delay passes, with interrupts enabled, before the call returns.
+ *         One delay at a time.
+ * \param  delayUs   Delay, up to 65535us. 0 calls back right away.
+ * \param  callback  Called once the delay has passed.
+ * \param  context   User data for the callback.
+ * \return false if the previous delay is still running, nothing started.
+ ******************************************************************************/
+bool PSC3M5_Timer_Start(uint16_t delayUs, PSC3M5_Timer_Callback callback, void *context);
+
+
+#endif /* SRC_MCU_TIMER_TIMER_H_ */
@@ -0,0 +1,166 @@
+#include "UART.h"
+#include "src/MCU/Profile/Profile.h"
+#include "src/MCU/Log/Log.h"
+#include "src/MCU/Scheduler/Scheduler.h"		// PSC3M5_SCHEDULER_HOST
+#include <stdint.h>
+#include <stdio.h>
+
+#ifndef PSC3M5_SCHEDULER_HOST
+#include "cy_retarget_io.h"
+#include "cycfg_peripherals.h"
+
+// Data structures required for the UART PC HAL.
+// Every interaction with these structures is internal, no FW assignments/reads.
+static cy_stc_scb_uart_context_t    UART_PC_context;
+static mtb_hal_uart_t               UART_PC_hal_obj;
+#endif
+
+
+// Line building blocks - each returns the position after the text written
+static char *append_text(char *out, const char *text)
+{
+	while(*text != '\0')
+	{
+		*out++ = *text++;
+	}
+
+	return out;
+}
+
+static char *append_uint(char *out, uint32_t value)
+{
+	char digits[10];
+	uint8_t count = 0;
+
+	do
+	{
+		digits[count++] = (char)('0' + (value % 10U));
+		value /= 10U;
+	} while(value != 0);
+
+	while(count != 0)
+	{
+		*out++ = digits[--count];
+	}
+
+	return out;
+}
+
+// Always 4 digits, upper case
+static char *append_hex16(char *out, uint16_t value)
+{
+	static const char hex[] = "0123456789ABCDEF";
+
+	*out++ = hex[(value >> 12) & 0xF];
+	*out++ = hex[(value >> 8) & 0xF];
+	*out++ = hex[(value >> 4) & 0xF];
+	*out++ = hex[value & 0xF];
+
+	return out;
+}
+
+// Milli-degrees as degrees with 3 decimals
+static char *append_mdeg(char *out, uint32_t mdeg)
+{
+	uint32_t fraction = mdeg % 1000U;
+
+	out = append_uint(out, mdeg / 1000U);
+	*out++ = '.';
+	*out++ = (char)('0' + (fraction / 100U));
+	*out++ = (char)('0' + ((fraction / 10U) % 10U));
+	*out++ = (char)('0' + (fraction % 10U));
+
+	return out;
+}
+
+
+#ifndef PSC3M5_SCHEDULER_HOST
+void PSC3M5_UART_Init(void)
+{
+	cy_rslt_t result;
+	
+	result = (cy_rslt_t)Cy_SCB_UART_Init(UART_PC_HW, &UART_PC_config, &UART_PC_context);
+	if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+	
+	Cy_SCB_UART_Enable(UART_PC_HW);
+	
+	result = mtb_hal_uart_setup(&UART_PC_hal_obj, &UART_PC_hal_config, &UART_PC_context, NULL);
+	if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+	
+	result = cy_retarget_io_init(&UART_PC_hal_obj);
+	if (result != CY_RSLT_SUCCESS)
+    {
+        CY_ASSERT(0);
+    }
+}
+#else
+void PSC3M5_UART_Init(void)
+{
+	// stdout is the serial port of a host build
+}
+#endif
+
+uint8_t PSC3M5_UART_FormatAngleInfo(char *line, uint16_t angle, uint32_t angleMdeg, uint8_t slave)
+{
+	char *out = line;
+
+	// Angle in hexadecimal
+	out = append_text(out, "Sensor");
+	out = append_uint(out, slave);
+	out = append_text(out, " ->ANGLE [LSB]: 0x");
+	out = append_hex16(out, angle);
+
+	// Angle in degrees
+	out = append_text(out, " | Sensor");
+	out = append_uint(out, slave);
+	out = append_text(out, " ->ANGLE [deg]: ");
+	out = append_mdeg(out, angleMdeg);
+	out = append_text(out, "\r\n");
+	*out = '\0';
+
+	return (uint8_t)(out - line);
+}
+
+void PSC3M5_UART_SendAngleInfo(uint16_t angle, uint8_t slave)
+{
+	PSC3M5_PROFILE_BEGIN(PSC3M5_PROFILE_UART);
+
+#if PSC3M5_LOG_ENABLE
+	// Raw values only, the host decoder builds the same line
+	PSC3M5_LOG4(ANGLE, slave, angle, slave, PSC3M5_ANGLE16_TO_MDEG(angle));
+#else
+	char line[PSC3M5_UART_ANGLE_LINE_MAX];
+	uint8_t length;
+
+	length = PSC3M5_UART_FormatAngleInfo(line, angle, PSC3M5_ANGLE16_TO_MDEG(angle), slave);
+
+	// Whole line in one output call
+	fwrite(line, 1, length, stdout);
+#endif
+
+	PSC3M5_PROFILE_END(PSC3M5_PROFILE_UART);
+}
+
+void PSC3M5_UART_SendSyncAngleInfo(uint16_t angle, uint8_t slave)
+{
+	PSC3M5_PROFILE_BEGIN(PSC3M5_PROFILE_UART);
+
+#if PSC3M5_LOG_ENABLE
+	PSC3M5_LOG4(ANGLE, slave, angle, slave, PSC3M5_ANGLE14_TO_MDEG(angle));	// 14 bit value
+#else
+	char line[PSC3M5_UART_ANGLE_LINE_MAX];
+	uint8_t length;
+
+	length = PSC3M5_UART_FormatAngleInfo(line, angle, PSC3M5_ANGLE14_TO_MDEG(angle), slave);	// 14 bit value
+
+	fwrite(line, 1, length, stdout);
+#endif
+
+	PSC3M5_PROFILE_END(PSC3M5_PROFILE_UART);
+}
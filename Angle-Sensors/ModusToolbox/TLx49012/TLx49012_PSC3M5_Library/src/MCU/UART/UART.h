@@ -0,0 +1,30 @@
+#ifndef SRC_MCU_UART_UART_H_
+#define SRC_MCU_UART_UART_H_
+
+
+#include "stdint.h"
+
+
+// Angle in milli-degrees, rounded - integer only, no softfloat calls.
+// 360000 / 2^n reduced to 45000 / 2^(n-3), so the product fits 32 bits.
+#define PSC3M5_ANGLE16_TO_MDEG(angle)	((((uint32_t)(angle) * 45000U) + (1U << 12)) >> 13)	// 16-bit full-scale
+#define PSC3M5_ANGLE14_TO_MDEG(angle)	((((uint32_t)(angle) * 45000U) + (1U << 10)) >> 11)	// 14-bit full-scale
+
+// Longest line built by PSC3M5_UART_FormatAngleInfo(), terminator included
+#define PSC3M5_UART_ANGLE_LINE_MAX		(80U)
+
+
+// Initializes the UART HAL for serial port communication.
+void PSC3M5_UART_Init(void);
+
+// Writes the angle line of a SPI slave into line[PSC3M5_UART_ANGLE_LINE_MAX], returns its length.
+uint8_t PSC3M5_UART_FormatAngleInfo(char *line, uint16_t angle, uint32_t angleMdeg, uint8_t slave);
+
+// Sends angle values for respective SPI slave to the serial port.
+void PSC3M5_UART_SendAngleInfo(uint16_t angle, uint8_t slave);
+
+// Sends sync angle values for respective SPI slave to the serial port.
+void PSC3M5_UART_SendSyncAngleInfo(uint16_t angle, uint8_t slave);
+
+
+#endif /* SRC_MCU_UART_UART_H_ */
@@ -0,0 +1,28 @@
+#include "src/Sensor/ConfigImage.h"
+
+#if TLX49012_CONFIG_IMAGE_ENABLE
+
+
+const uint16_t g_TLx49012_ConfigImage[TLX49012_CONFIG_IMAGE_COUNT] =
+{
+	TLX49012_CFG_USR_CONFIG_1,  TLX49012_CFG_USR_CONFIG_2,  TLX49012_CFG_USR_CONFIG_3,
+	TLX49012_CFG_USR_CONFIG_4,  TLX49012_CFG_USR_CONFIG_5,  TLX49012_CFG_USR_CONFIG_6,
+	TLX49012_CFG_USR_CONFIG_7,  TLX49012_CFG_USR_CONFIG_8,  TLX49012_CFG_USR_CONFIG_9,
+	TLX49012_CFG_USR_CONFIG_10, TLX49012_CFG_USR_CONFIG_11, TLX49012_CFG_USR_CONFIG_12,
+	TLX49012_CFG_USR_CONFIG_13, TLX49012_CFG_USR_CONFIG_14, TLX49012_CFG_USR_CONFIG_15_CRC
+};
+
+const uint8_t g_TLx49012_ConfigImageFrames[TLX49012_CONFIG_IMAGE_FRAMES][4] =
+{
+	XENSIV_NXF_COMMAND_FRAME(TLX49012_CONFIG_IMAGE_FIRST_ADDR, XENSIV_NXF_AC_WRITE_INC),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_1),  XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_2),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_3),  XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_4),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_5),  XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_6),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_7),  XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_8),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_9),  XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_10),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_11), XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_12),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_13), XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_14),
+	XENSIV_NXF_WRITE_FRAME(TLX49012_CFG_USR_CONFIG_15_CRC)
+};
+
+#endif /* TLX49012_CONFIG_IMAGE_ENABLE */
@@ -0,0 +1,146 @@
+#ifndef SRC_SENSOR_CONFIGIMAGE_H_
+#define SRC_SENSOR_CONFIGIMAGE_H_
+
+
+#include "stdint.h"
+#include "xensiv_crc.h"
+#include "xensiv_nextframe.h"
+#include "src/Sensor/ConfigShadow.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------CONFIGURABLE PARAMETERS--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Build-time user configuration image, off by default. Enable with DEFINES+=TLX49012_CONFIG_IMAGE_ENABLE=1
+// in the Makefile: TLx49012_Init() then writes the whole user configuration area (0x3F-0x4D) with its
+// block CRC in one burst, instead of the single USR_CONFIG_1 write. The register words below 0x41 are
+// described field by field; the others differ per sensor variant and have to be given as read from the
+// sensor, e.g. with TLx49012_ShadowRefresh() or CMD_SPI_READ_BM_USR_CONFIG of the evaluation kit.
+#ifndef TLX49012_CONFIG_IMAGE_ENABLE
+#define TLX49012_CONFIG_IMAGE_ENABLE		0
+#endif
+
+// USR_CONFIG_1 (0x3F) - defaults give USR_CONFIG_1_DATA: SPI + SYNC ON IFE + FALLING EDGE SYNC
+#ifndef TLX49012_CFG_IF_MODE
+#define TLX49012_CFG_IF_MODE				0		// Interface mode, 3 bits
+#endif
+#ifndef TLX49012_CFG_PWM_FREQ
+#define TLX49012_CFG_PWM_FREQ				0		// PWM frequency, 3 bits
+#endif
+#ifndef TLX49012_CFG_PWM_START_EDGE
+#define TLX49012_CFG_PWM_START_EDGE			0		// PWM starting edge
+#endif
+#ifndef TLX49012_CFG_SYNC_MODE
+#define TLX49012_CFG_SYNC_MODE				0		// Synchronization mode, 2 bits
+#endif
+#ifndef TLX49012_CFG_SYNC_EDGE
+#define TLX49012_CFG_SYNC_EDGE				2		// Synchronization edge, 2 bits
+#endif
+#ifndef TLX49012_CFG_SPI_MOSI_CRC_DIS
+#define TLX49012_CFG_SPI_MOSI_CRC_DIS		0		// SPI MOSI CRC disable
+#endif
+#ifndef TLX49012_CFG_SPI_MISO_CRC_INV_DIS
+#define TLX49012_CFG_SPI_MISO_CRC_INV_DIS	0		// SPI MISO CRC invert disable - keep 0, see xensiv_response.h
+#endif
+#ifndef TLX49012_CFG_ABZ_MODE
+#define TLX49012_CFG_ABZ_MODE				0		// ABZ mode
+#endif
+#ifndef TLX49012_CFG_ABZ_INIT_POS_MODE
+#define TLX49012_CFG_ABZ_INIT_POS_MODE		0		// ABZ initial position
+#endif
+#ifndef TLX49012_CFG_ADC_MAX_RNG_EN
+#define TLX49012_CFG_ADC_MAX_RNG_EN			0		// ADC max range enable
+#endif
+
+// USR_CONFIG_2 (0x40) - TLX49012_CFG_ABZ_Z_MODE (2 bits) and TLX49012_CFG_ABZ_UVW_PULSES_PP (12 bits:
+// ABZ pulses per revolution - 1, or UVW pole pairs - 1), no defaults
+
+// USR_CONFIG_3 to USR_CONFIG_15 (0x41-0x4D) - TLX49012_CFG_USR_CONFIG_3 ... TLX49012_CFG_USR_CONFIG_15,
+// register words, no defaults. The CRC byte of USR_CONFIG_15 is replaced by the block CRC.
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+#define TLX49012_CONFIG_IMAGE_FIRST_ADDR	TLX49012_SHADOW_FIRST_ADDR
+#define TLX49012_CONFIG_IMAGE_COUNT			TLX49012_SHADOW_COUNT
+
+// CMD_ADDR with AC_WRITE_INC, then one write frame per register
+#define TLX49012_CONFIG_IMAGE_FRAMES		XENSIV_NXF_WRITE_BURST_FRAMES(TLX49012_CONFIG_IMAGE_COUNT)
+
+#if TLX49012_CONFIG_IMAGE_ENABLE
+
+#if !defined(TLX49012_CFG_ABZ_Z_MODE) || !defined(TLX49012_CFG_ABZ_UVW_PULSES_PP) ||							\
+	!defined(TLX49012_CFG_USR_CONFIG_3) || !defined(TLX49012_CFG_USR_CONFIG_4) ||								\
+	!defined(TLX49012_CFG_USR_CONFIG_5) || !defined(TLX49012_CFG_USR_CONFIG_6) ||								\
+	!defined(TLX49012_CFG_USR_CONFIG_7) || !defined(TLX49012_CFG_USR_CONFIG_8) ||								\
+	!defined(TLX49012_CFG_USR_CONFIG_9) || !defined(TLX49012_CFG_USR_CONFIG_10) ||								\
+	!defined(TLX49012_CFG_USR_CONFIG_11) || !defined(TLX49012_CFG_USR_CONFIG_12) ||							\
+	!defined(TLX49012_CFG_USR_CONFIG_13) || !defined(TLX49012_CFG_USR_CONFIG_14) ||							\
+	!defined(TLX49012_CFG_USR_CONFIG_15)
+#error "TLX49012_CONFIG_IMAGE_ENABLE needs USR_CONFIG_2 to USR_CONFIG_15 of the sensor variant, see ConfigImage.h"
+#endif
+
+// Register words of the image
+#define TLX49012_CFG_USR_CONFIG_1												\
+	( ((TLX49012_CFG_IF_MODE & 0x7) << 0)			|							\
+	  ((TLX49012_CFG_PWM_FREQ & 0x7) << 3)			|							\
+	  ((TLX49012_CFG_PWM_START_EDGE & 0x1) << 6)	|							\
+	  ((TLX49012_CFG_SYNC_MODE & 0x3) << 7)			|							\
+	  ((TLX49012_CFG_SYNC_EDGE & 0x3) << 9)			|							\
+	  ((TLX49012_CFG_SPI_MOSI_CRC_DIS & 0x1) << 11)	|							\
+	  ((TLX49012_CFG_SPI_MISO_CRC_INV_DIS & 0x1) << 12) |						\
+	  ((TLX49012_CFG_ABZ_MODE & 0x1) << 13)			|							\
+	  ((TLX49012_CFG_ABZ_INIT_POS_MODE & 0x1) << 14) |							\
+	  ((TLX49012_CFG_ADC_MAX_RNG_EN & 0x1) << 15) )
+
+#define TLX49012_CFG_USR_CONFIG_2												\
+	( ((TLX49012_CFG_ABZ_UVW_PULSES_PP & 0xFFF) << 0) |							\
+	  ((TLX49012_CFG_ABZ_Z_MODE & 0x3) << 12) )
+
+// Block CRC, one step per word: CRC8 SAE J1850, seed 0xAA, MSB then LSB (same byte order as
+// CalcUserConfigCRC() of the Arduino examples)
+#define TLX49012_CFG_CRC_WORD(crc, word)										\
+	XENSIV_CRC8_J1850_STEP(XENSIV_CRC8_J1850_STEP((crc), (((word) >> 8) & 0xFF)), ((word) & 0xFF))
+
+// Each intermediate CRC is a named constant, so the preprocessor never nests more than two steps
+enum
+{
+	TLX49012_CFG_CRC_0	= XENSIV_CRC8_J1850_SEED_CONFIG,
+	TLX49012_CFG_CRC_1	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_0,  TLX49012_CFG_USR_CONFIG_1),
+	TLX49012_CFG_CRC_2	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_1,  TLX49012_CFG_USR_CONFIG_2),
+	TLX49012_CFG_CRC_3	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_2,  TLX49012_CFG_USR_CONFIG_3),
+	TLX49012_CFG_CRC_4	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_3,  TLX49012_CFG_USR_CONFIG_4),
+	TLX49012_CFG_CRC_5	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_4,  TLX49012_CFG_USR_CONFIG_5),
+	TLX49012_CFG_CRC_6	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_5,  TLX49012_CFG_USR_CONFIG_6),
+	TLX49012_CFG_CRC_7	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_6,  TLX49012_CFG_USR_CONFIG_7),
+	TLX49012_CFG_CRC_8	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_7,  TLX49012_CFG_USR_CONFIG_8),
+	TLX49012_CFG_CRC_9	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_8,  TLX49012_CFG_USR_CONFIG_9),
+	TLX49012_CFG_CRC_10	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_9,  TLX49012_CFG_USR_CONFIG_10),
+	TLX49012_CFG_CRC_11	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_10, TLX49012_CFG_USR_CONFIG_11),
+	TLX49012_CFG_CRC_12	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_11, TLX49012_CFG_USR_CONFIG_12),
+	TLX49012_CFG_CRC_13	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_12, TLX49012_CFG_USR_CONFIG_13),
+	TLX49012_CFG_CRC_14	= TLX49012_CFG_CRC_WORD(TLX49012_CFG_CRC_13, TLX49012_CFG_USR_CONFIG_14),
+	// CRC line: only its MSB is covered
+	TLX49012_CFG_CRC_15	= XENSIV_CRC8_J1850_STEP(TLX49012_CFG_CRC_14, ((TLX49012_CFG_USR_CONFIG_15 >> 8) & 0xFF))
+};
+
+#define TLX49012_CONFIG_IMAGE_CRC			((uint8_t)(~TLX49012_CFG_CRC_15 & 0xFF))
+
+// CRC line as written: data MSB kept, block CRC in the LSB
+#define TLX49012_CFG_USR_CONFIG_15_CRC		((TLX49012_CFG_USR_CONFIG_15 & 0xFF00) | TLX49012_CONFIG_IMAGE_CRC)
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// The image, CRC line included. Lives in flash.
+extern const uint16_t g_TLx49012_ConfigImage[TLX49012_CONFIG_IMAGE_COUNT];
+
+// Next-frame burst writing the image, all frame CRCs included. Lives in flash.
+extern const uint8_t g_TLx49012_ConfigImageFrames[TLX49012_CONFIG_IMAGE_FRAMES][4];
+
+#endif /* TLX49012_CONFIG_IMAGE_ENABLE */
+
+
+#endif /* SRC_SENSOR_CONFIGIMAGE_H_ */
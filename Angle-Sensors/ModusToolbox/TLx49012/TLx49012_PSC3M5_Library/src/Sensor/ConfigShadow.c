@@ -0,0 +1,251 @@
+#include "src/Sensor/ConfigShadow.h"
+#include <stddef.h>
+
+
+#define SHADOW_CONTAINS(addr)	(((addr) >= TLX49012_SHADOW_FIRST_ADDR) && ((addr) <= TLX49012_SHADOW_LAST_ADDR))
+#define SHADOW_INDEX(addr)		((uint8_t)((addr) - TLX49012_SHADOW_FIRST_ADDR))
+#define SHADOW_ALL				((uint16_t)((1UL << TLX49012_SHADOW_COUNT) - 1U))
+
+// Per-sensor copy of the user configuration area
+typedef struct
+{
+	uint16_t value[TLX49012_SHADOW_COUNT];	// Last value written or read
+	uint16_t known;							// Bit i: value[i] is valid
+	uint16_t unverified;					// Bit i: written since the last TLx49012_ShadowVerify()
+} config_shadow;
+
+static config_shadow shadow[TLX49012_SENSOR_COUNT];
+
+// One transaction per register and sensor, plus the CMD_ADDR frame of a burst - main loop only, not reentrant
+static PSC3M5_SPI_Transaction shadow_plan[(TLX49012_SHADOW_COUNT + 1) * TLX49012_SENSOR_COUNT];
+
+
+// Queues reads of the registers in mask (bit i = register i), for all selected sensors
+static uint8_t plan_reads(uint8_t sensors, const uint16_t *masks)
+{
+	uint8_t count = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(!(sensors & (1U << slave)))
+		{
+			continue;
+		}
+
+		for(uint8_t i = 0; i < TLX49012_SHADOW_COUNT; i++)
+		{
+			if(masks[slave] & (1U << i))
+			{
+				shadow_plan[count].slaveSelect = slave;
+				shadow_plan[count].txFrame     = TLx49012_GetReadFrame(TLX49012_SHADOW_FIRST_ADDR + i, false);
+				shadow_plan[count].callback    = NULL;
+				count++;
+			}
+		}
+	}
+
+	TLx49012_SPI_SendPlan(shadow_plan, count);
+
+	return count;
+}
+
+
+void TLx49012_ShadowInvalidate(uint8_t sensors)
+{
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(sensors & (1U << slave))
+		{
+			shadow[slave].known      = 0;
+			shadow[slave].unverified = 0;
+		}
+	}
+}
+
+void TLx49012_ShadowRefresh(uint8_t sensors)
+{
+	uint16_t masks[TLX49012_SENSOR_COUNT];
+	uint8_t count;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		masks[slave] = SHADOW_ALL;
+	}
+
+	count = plan_reads(sensors, masks);
+
+	// Plan order: sensor, then register
+	for(uint8_t j = 0; j < count; j++)
+	{
+		config_shadow *s = &shadow[shadow_plan[j].slaveSelect];
+		uint8_t i = j % TLX49012_SHADOW_COUNT;
+
+		if(i == 0)
+		{
+			s->known      = 0;
+			s->unverified = 0;
+		}
+
+		// A register read back corrupted stays unknown, the next write goes out
+		if(shadow_plan[j].frame.error == 0)
+		{
+			s->value[i] = shadow_plan[j].frame.data;
+			s->known   |= (uint16_t)(1U << i);
+		}
+	}
+}
+
+uint8_t TLx49012_ShadowDiffers(uint8_t addr, uint16_t data, uint8_t sensors)
+{
+	uint8_t differs = 0;
+
+	if(!SHADOW_CONTAINS(addr))
+	{
+		return sensors;
+	}
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		const config_shadow *s = &shadow[slave];
+
+		if((sensors & (1U << slave)) &&
+		   (!(s->known & (1U << SHADOW_INDEX(addr))) || (s->value[SHADOW_INDEX(addr)] != data)))
+		{
+			differs |= (uint8_t)(1U << slave);
+		}
+	}
+
+	return differs;
+}
+
+uint8_t TLx49012_ShadowWrite(uint8_t addr, uint16_t data, uint8_t sensors)
+{
+	uint8_t frame[4];
+	uint8_t count = 0;
+	uint8_t written = TLx49012_ShadowDiffers(addr, data, sensors);
+
+	if(written == 0)
+	{
+		return 0;
+	}
+
+	// Same write frame for all sensors, built once
+	frame[0] = (uint8_t)(((addr & 0x7F) << 1) | 1);		// 7bit address 1 bit R/W
+	frame[1] = (uint8_t)((data >> 8) & 0xFF);			// 1 data byte MSB
+	frame[2] = (uint8_t)(data & 0xFF);					// 1 data byte LSB
+	frame[3] = CalcCRC(frame, 3);						// 1 byte CRC
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(written & (1U << slave))
+		{
+			shadow_plan[count].slaveSelect = slave;
+			shadow_plan[count].txFrame     = frame;
+			shadow_plan[count].callback    = NULL;
+			count++;
+
+			if(SHADOW_CONTAINS(addr))
+			{
+				shadow[slave].value[SHADOW_INDEX(addr)] = data;
+				shadow[slave].known      |= (uint16_t)(1U << SHADOW_INDEX(addr));
+				shadow[slave].unverified |= (uint16_t)(1U << SHADOW_INDEX(addr));
+			}
+		}
+	}
+
+	TLx49012_SPI_SendPlan(shadow_plan, count);
+
+	return written;
+}
+
+void TLx49012_ShadowWriteArea(const uint16_t image[TLX49012_SHADOW_COUNT], const uint8_t frames[][4], uint8_t sensors)
+{
+	uint8_t count = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(!(sensors & (1U << slave)))
+		{
+			continue;
+		}
+
+		// Burst frames are constant, shared by all sensors
+		for(uint8_t i = 0; i <= TLX49012_SHADOW_COUNT; i++)
+		{
+			shadow_plan[count].slaveSelect = slave;
+			shadow_plan[count].txFrame     = frames[i];
+			shadow_plan[count].callback    = NULL;
+			count++;
+		}
+
+		for(uint8_t i = 0; i < TLX49012_SHADOW_COUNT; i++)
+		{
+			shadow[slave].value[i] = image[i];
+		}
+		shadow[slave].known      = SHADOW_ALL;
+		shadow[slave].unverified = SHADOW_ALL;
+	}
+
+	TLx49012_SPI_SendPlan(shadow_plan, count);
+}
+
+uint8_t TLx49012_ShadowVerify(uint8_t sensors)
+{
+	uint16_t masks[TLX49012_SENSOR_COUNT];
+	uint8_t verified = sensors;
+	uint8_t count;
+	uint8_t j = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		masks[slave] = shadow[slave].unverified;
+	}
+
+	count = plan_reads(sensors, masks);
+
+	// Walk the plan in the order it was built
+	for(uint8_t slave = 0; (slave < TLX49012_SENSOR_COUNT) && (j < count); slave++)
+	{
+		if(!(sensors & (1U << slave)))
+		{
+			continue;
+		}
+
+		for(uint8_t i = 0; i < TLX49012_SHADOW_COUNT; i++)
+		{
+			if(masks[slave] & (1U << i))
+			{
+				const xensiv_rsp_frame_t *frame = &shadow_plan[j++].frame;
+
+				if(frame->error != 0)
+				{
+					shadow[slave].known &= (uint16_t)~(1U << i);
+					verified &= (uint8_t)~(1U << slave);
+				}
+				else if(frame->data != shadow[slave].value[i])
+				{
+					shadow[slave].value[i] = frame->data;
+					verified &= (uint8_t)~(1U << slave);
+				}
+			}
+		}
+
+		shadow[slave].unverified = 0;
+	}
+
+	return verified;
+}
+
+bool TLx49012_ShadowGet(uint8_t addr, uint16_t *data, uint8_t slaveSelect)
+{
+	const config_shadow *s = &shadow[slaveSelect % TLX49012_SENSOR_COUNT];
+
+	if(!SHADOW_CONTAINS(addr) || !(s->known & (1U << SHADOW_INDEX(addr))))
+	{
+		return false;
+	}
+
+	*data = s->value[SHADOW_INDEX(addr)];
+
+	return true;
+}
@@ -0,0 +1,101 @@
+#ifndef SRC_SENSOR_CONFIGSHADOW_H_
+#define SRC_SENSOR_CONFIGSHADOW_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "src/Sensor/TLx49012.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// User configuration area mirrored by the shadow
+#define TLX49012_SHADOW_FIRST_ADDR		0x3F
+#define TLX49012_SHADOW_LAST_ADDR		0x4D
+#define TLX49012_SHADOW_COUNT			(TLX49012_SHADOW_LAST_ADDR - TLX49012_SHADOW_FIRST_ADDR + 1)
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowInvalidate
+ ***************************************************************************//**
+ * \brief  	Forgets the shadow of the selected sensors, e.g. after power-on or
+ *			a reset from NVM. The next write of each register goes to the sensor.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ ******************************************************************************/
+void TLx49012_ShadowInvalidate(uint8_t sensors);
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowRefresh
+ ***************************************************************************//**
+ * \brief  	Reads the whole user configuration area of the selected sensors
+ *			into the shadow, all reads queued back to back as one plan.
+ *			Registers whose response fails the check are left unknown.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ ******************************************************************************/
+void TLx49012_ShadowRefresh(uint8_t sensors);
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowDiffers
+ ***************************************************************************//**
+ * \brief  	Compares a register with the shadow, no SPI traffic.
+ * \param  	addr		Register address.
+ * \param  	data		Register content to compare with.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ * \return 	Sensors whose register is unknown or holds other data. Registers
+ *			outside the user configuration area always differ.
+ ******************************************************************************/
+uint8_t TLx49012_ShadowDiffers(uint8_t addr, uint16_t data, uint8_t sensors);
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowWrite
+ ***************************************************************************//**
+ * \brief  	Writes a register of the selected sensors, skipping the sensors whose
+ *			shadow already holds the data. The writes are queued as one plan and
+ *			left for TLx49012_ShadowVerify(). The sensors must be unlocked.
+ * \param  	addr		Register address.
+ * \param  	data		Data to be written.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ * \return 	Sensors written.
+ ******************************************************************************/
+uint8_t TLx49012_ShadowWrite(uint8_t addr, uint16_t data, uint8_t sensors);
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowWriteArea
+ ***************************************************************************//**
+ * \brief  	Writes the whole user configuration area of the selected sensors
+ *			with a prebuilt next-frame burst (CMD_ADDR with AC_WRITE_INC, then
+ *			one write frame per register), all sensors in one plan. The shadow
+ *			takes the image, all registers are left for TLx49012_ShadowVerify().
+ *			The sensors must be unlocked.
+ * \param  	image		Register words, CRC line included.
+ * \param  	frames		TLX49012_SHADOW_COUNT + 1 frames writing image.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ ******************************************************************************/
+void TLx49012_ShadowWriteArea(const uint16_t image[TLX49012_SHADOW_COUNT], const uint8_t frames[][4], uint8_t sensors);
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowVerify
+ ***************************************************************************//**
+ * \brief  	Reads back all registers written since the last verification, for
+ *			all selected sensors in one plan. A mismatching register takes the
+ *			value read, so that a retry writes it again. A register whose
+ *			response fails the check becomes unknown and is not verified.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ * \return 	Sensors whose registers all hold the written data.
+ ******************************************************************************/
+uint8_t TLx49012_ShadowVerify(uint8_t sensors);
+
+/*******************************************************************************
+ * Function Name: TLx49012_ShadowGet
+ ***************************************************************************//**
+ * \brief  	Returns the last value written to or read from a register.
+ * \param  	addr			Register address.
+ * \param  	data			Register content.
+ * \param  	slaveSelect		SPI slave select.
+ * \return 	false if the register is not known.
+ ******************************************************************************/
+bool TLx49012_ShadowGet(uint8_t addr, uint16_t *data, uint8_t slaveSelect);
+
+
+#endif /* SRC_SENSOR_CONFIGSHADOW_H_ */
@@ -0,0 +1,20 @@
+#include "CRC8_SAE_J1850.h"
+// The CRC tables of the library live here
+#define XENSIV_CRC_DEFINE_TABLES
+#include "xensiv_crc.h"
+#include "src/MCU/Profile/Profile.h"
+
+
+uint8_t CalcCRC(const uint8_t * buf, uint8_t len) 
+{
+    uint8_t crc;
+
+    PSC3M5_PROFILE_BEGIN(PSC3M5_PROFILE_CRC);
+
+    // LUT is generated at compile time by the shared CRC library
+    crc = xensiv_crc8_j1850(buf, len, XENSIV_CRC8_J1850_SEED_SPI);
+
+    PSC3M5_PROFILE_END(PSC3M5_PROFILE_CRC);
+
+    return crc;
+}
@@ -0,0 +1,16 @@
+#include "SPI_FrameCache.h"
+
+
+// Table generators - expand to consecutive read frames starting at address a
+#define READ_FRAMES_1(a, clr)	TLX49012_READ_FRAME((a), (clr))
+#define READ_FRAMES_4(a, clr)	READ_FRAMES_1((a), clr),  READ_FRAMES_1((a) + 1, clr),  READ_FRAMES_1((a) + 2, clr),  READ_FRAMES_1((a) + 3, clr)
+#define READ_FRAMES_16(a, clr)	READ_FRAMES_4((a), clr),  READ_FRAMES_4((a) + 4, clr),  READ_FRAMES_4((a) + 8, clr),  READ_FRAMES_4((a) + 12, clr)
+#define READ_FRAMES_64(a, clr)	READ_FRAMES_16((a), clr), READ_FRAMES_16((a) + 16, clr), READ_FRAMES_16((a) + 32, clr), READ_FRAMES_16((a) + 48, clr)
+#define READ_FRAMES_128(clr)	READ_FRAMES_64(0, clr),   READ_FRAMES_64(64, clr)
+
+
+const uint8_t g_TLx49012_ReadFrameCache[2][TLX49012_FRAME_ADDR_COUNT][4] =
+{
+	{ READ_FRAMES_128(false) },		// No status clearing
+	{ READ_FRAMES_128(true)  }		// Clear device status
+};
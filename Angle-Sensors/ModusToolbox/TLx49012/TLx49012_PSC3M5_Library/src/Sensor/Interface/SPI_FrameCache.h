@@ -0,0 +1,60 @@
+#ifndef SRC_SENSOR_INTERFACE_SPI_FRAMECACHE_H_
+#define SRC_SENSOR_INTERFACE_SPI_FRAMECACHE_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "xensiv_crc.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Number of 7-bit in-frame register addresses
+#define TLX49012_FRAME_ADDR_COUNT		128
+
+// Compile-time equivalent of CalcCRC() over the first three frame bytes
+#define TLX49012_FRAME_CRC(b0, b1, b2)									\
+	XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, (b0), (b1), (b2))
+
+// In-frame read command: 7bit address + R/W = 0, unused byte, clear status byte, CRC
+#define TLX49012_READ_FRAME(addr, clearStatus)							\
+	{																	\
+		(uint8_t)(((addr) & 0x7F) << 1),								\
+		0x00,															\
+		(uint8_t)((clearStatus) ? 0xFF : 0x00),							\
+		TLX49012_FRAME_CRC((((addr) & 0x7F) << 1), 0x00, ((clearStatus) ? 0xFF : 0x00))	\
+	}
+
+// In-frame write command: 7bit address + R/W = 1, data MSB, data LSB, CRC
+#define TLX49012_WRITE_FRAME(addr, data)								\
+	{																	\
+		(uint8_t)((((addr) & 0x7F) << 1) | 1),							\
+		(uint8_t)(((data) >> 8) & 0xFF),								\
+		(uint8_t)((data) & 0xFF),										\
+		TLX49012_FRAME_CRC(((((addr) & 0x7F) << 1) | 1), (((data) >> 8) & 0xFF), ((data) & 0xFF))	\
+	}
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// All in-frame read commands, indexed by [clearStatus][address]. Lives in flash.
+extern const uint8_t g_TLx49012_ReadFrameCache[2][TLX49012_FRAME_ADDR_COUNT][4];
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_GetReadFrame
+ ***************************************************************************//**
+ * \brief  Returns the precomputed in-frame read command for an address.
+ * \param  addr         Read address, 7-bit.
+ * \param  clearStatus  If true, the command clears the device status.
+ * \return Pointer to the 4-byte command frame, CRC included.
+ ******************************************************************************/
+static inline const uint8_t * TLx49012_GetReadFrame(uint8_t addr, bool clearStatus)
+{
+	return g_TLx49012_ReadFrameCache[clearStatus ? 1 : 0][addr & 0x7F];
+}
+
+
+#endif /* SRC_SENSOR_INTERFACE_SPI_FRAMECACHE_H_ */
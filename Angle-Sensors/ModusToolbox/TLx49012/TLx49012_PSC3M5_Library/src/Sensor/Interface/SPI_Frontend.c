@@ -0,0 +1,90 @@
+#include "SPI_Frontend.h"
+#include "CRC8_SAE_J1850.h"
+#include "SPI_FrameCache.h"
+#include "xensiv_nextframe.h"
+#include <stdint.h>
+
+
+uint32_t TLx49012_SPI_WriteInFrame(uint8_t addr, uint16_t data, uint8_t slaveSelect)
+{
+	static uint8_t data_to_send[4] 	= {0,0,0,0};
+	static bool r_w					= 1;
+
+	data_to_send[0] = (addr << 1) | (r_w & 1); 				// 7bit address 1 bit R/W
+	data_to_send[1] = (data >> 8) & 0xFF;					// 1 data byte MSB
+	data_to_send[2] = data & 0xFF;							// 1 data byte LSB
+	data_to_send[3] = CalcCRC(data_to_send, 3);	// 1 byte CRC
+
+	// Assemble 32-bit command
+	//data_to_send = (data_temp[0] << 24) | (data_temp[1] << 16) | (data_temp[2] << 8) | data_temp[3];
+	
+	return PSC3M5_SPI_SendReceive(data_to_send, slaveSelect);
+}
+
+uint32_t TLx49012_SPI_ReadInFrame(uint8_t addr, bool clearStatus, uint8_t slaveSelect)
+{
+	// Read commands are precomputed - no frame assembly or CRC on this path
+	return PSC3M5_SPI_SendReceive(TLx49012_GetReadFrame(addr, clearStatus), slaveSelect);
+}
+
+xensiv_rsp_frame_t TLx49012_SPI_ReadInFrameChecked(uint8_t addr, bool clearStatus, uint8_t slaveSelect)
+{
+	return PSC3M5_SPI_SendReceiveFrame(TLx49012_GetReadFrame(addr, clearStatus), slaveSelect);
+}
+
+uint32_t TLx49012_SPI_SendFrame(const uint8_t *frame, uint8_t slaveSelect)
+{
+	return PSC3M5_SPI_SendReceive(frame, slaveSelect);
+}
+
+void TLx49012_SPI_SendPlan(PSC3M5_SPI_Transaction *plan, uint8_t count)
+{
+	PSC3M5_SPI_RunPlan(plan, count);
+}
+
+bool TLx49012_SPI_SubmitFrame(PSC3M5_SPI_Transaction *transaction)
+{
+	return PSC3M5_SPI_Submit(transaction);
+}
+
+uint8_t TLx49012_SPI_ReadRegList(const uint16_t *addrList, uint8_t count, bool clearStatus, uint16_t *data, uint8_t slaveSelect)
+{
+	uint8_t frames[XENSIV_NXF_READ_LIST_FRAMES(TLX49012_REG_LIST_MAX)][4];
+	PSC3M5_SPI_Transaction plan[XENSIV_NXF_READ_LIST_FRAMES(TLX49012_REG_LIST_MAX)] = { 0 };
+	uint8_t frameCount;
+	bool failed = false;
+
+	if(count > TLX49012_REG_LIST_MAX)
+	{
+		return 0;
+	}
+
+	frameCount = (uint8_t)xensiv_nxf_plan_read_list(addrList, count, clearStatus, frames);
+
+	if(frameCount == 0)
+	{
+		return 0;
+	}
+
+	for(uint8_t i = 0; i < frameCount; i++)
+	{
+		plan[i].slaveSelect = slaveSelect;
+		plan[i].txFrame     = frames[i];
+	}
+
+	PSC3M5_SPI_RunPlan(plan, frameCount);
+
+	// The first response belongs to whatever was addressed before the list. The others were
+	// decoded and counted per slave in the completion path - one failing the check fails the list
+	for(uint8_t i = 0; i < count; i++)
+	{
+		if(plan[i + 1].frame.error != 0)
+		{
+			failed = true;
+			continue;
+		}
+		data[i] = plan[i + 1].frame.data;
+	}
+
+	return failed ? 0 : frameCount;
+}
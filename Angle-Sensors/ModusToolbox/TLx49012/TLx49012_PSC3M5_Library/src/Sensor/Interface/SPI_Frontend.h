@@ -0,0 +1,112 @@
+#ifndef SRC_SENSOR_SPI_FRONTEND_H_
+#define SRC_SENSOR_SPI_FRONTEND_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "src/MCU/SPI/SPI_Backend.h"
+#include "src/Sensor/Interface/CRC8_SAE_J1850.h"
+#include "src/Sensor/Interface/SPI_FrameCache.h"
+
+// Longest register list of TLx49012_SPI_ReadRegList()
+#define TLX49012_REG_LIST_MAX		(16U)
+
+
+/*******************************************************************************
+ * Function Name: SPI_WriteInFrame
+ ***************************************************************************//**
+ * \brief  Sends a write command via SPI with in-frame sensor response.
+ *         Command and response are transmitted in the same SPI frame.
+ * \param  addr  Write address.
+ * \param  data  Data to be written.
+ * \param slaveSelect SPI slave select.
+ * \return  Full 32-bit sensor response.
+ ****************(*************************************************************/
+uint32_t TLx49012_SPI_WriteInFrame(uint8_t addr, uint16_t data, uint8_t slaveSelect);
+
+
+/*******************************************************************************
+ * Function Name: SPI_ReadInFrame
+ ***************************************************************************//**
+ * \brief  Sends a read command via SPI with in-frame sensor response.
+ *         Command and response are transmitted in the same SPI frame.
+ * \param  addr         Read address.
+ * \param  clearStatus  If true, device status register is cleared.
+ * \param  slaveSelect SPI slave select.
+ * \return  Full 32-bit sensor response.
+ ******************************************************************************/
+uint32_t TLx49012_SPI_ReadInFrame(uint8_t addr, bool clearStatus, uint8_t slaveSelect);
+
+
+/*******************************************************************************
+ * Function Name: SPI_ReadInFrameChecked
+ ***************************************************************************//**
+ * \brief  Same read as TLx49012_SPI_ReadInFrame(), with the response decoded
+ *         and checked in the SPI completion path.
+ * \param  addr         Read address.
+ * \param  clearStatus  If true, device status register is cleared.
+ * \param  slaveSelect SPI slave select.
+ * \return  Register data and device status, error set if the response failed
+ *          the CRC or status check.
+ ******************************************************************************/
+xensiv_rsp_frame_t TLx49012_SPI_ReadInFrameChecked(uint8_t addr, bool clearStatus, uint8_t slaveSelect);
+
+
+/*******************************************************************************
+ * Function Name: SPI_SendFrame
+ ***************************************************************************//**
+ * \brief  Sends a prebuilt command frame via SPI with in-frame sensor response.
+ *         Use with TLX49012_WRITE_FRAME()/TLx49012_GetReadFrame() so that
+ *         constant commands cost no frame assembly or CRC at run time.
+ * \param  frame        4-byte command frame, CRC included.
+ * \param  slaveSelect SPI slave select.
+ * \return  Full 32-bit sensor response.
+ ******************************************************************************/
+uint32_t TLx49012_SPI_SendFrame(const uint8_t *frame, uint8_t slaveSelect);
+
+
+/*******************************************************************************
+ * Function Name: SPI_SendPlan
+ ***************************************************************************//**
+ * \brief  Sends a list of prebuilt frames, possibly to different slaves, as
+ *         one sequence. All responses are available when the call returns.
+ * \param  plan   Transactions, executed in order. Responses are stored in
+ *                plan[i].response.
+ * \param  count  Number of transactions.
+ ******************************************************************************/
+void TLx49012_SPI_SendPlan(PSC3M5_SPI_Transaction *plan, uint8_t count);
+
+
+/*******************************************************************************
+ * Function Name: SPI_SubmitFrame
+ ***************************************************************************//**
+ * \brief  Queues a prebuilt frame without waiting for the response, so that
+ *         control code can run while the frame is on the wire.
+ * \param  transaction  Slave select, frame and optional completion callback.
+ *                      Must stay valid until transaction->done is set.
+ * \return false if the SPI queue is full.
+ ******************************************************************************/
+bool TLx49012_SPI_SubmitFrame(PSC3M5_SPI_Transaction *transaction);
+
+
+/*******************************************************************************
+ * Function Name: SPI_ReadRegList
+ ***************************************************************************//**
+ * \brief  Reads a list of registers with pipelined next-frame commands. The
+ *         command of register N+1 travels in the frame that returns register
+ *         N and contiguous addresses use AC_READ_INC, so K registers cost
+ *         K+1 frames, queued back to back as one plan.
+ * \param  addrList     Register addresses, 14-bit, any order.
+ * \param  count        Number of registers, up to TLX49012_REG_LIST_MAX.
+ * \param  clearStatus  If true, the last frame clears the device status.
+ * \param  data         Destination, register data in addrList order. Entries
+ *                      whose response fails the check are left unchanged.
+ * \param  slaveSelect  SPI slave select.
+ * \return Number of frames sent, 0 if count is 0 or too large, or if any
+ *         response failed the CRC or status check (counted per slave in
+ *         PSC3M5_SPI_GetFrameErrors()).
+ ******************************************************************************/
+uint8_t TLx49012_SPI_ReadRegList(const uint16_t *addrList, uint8_t count, bool clearStatus, uint16_t *data, uint8_t slaveSelect);
+
+
+#endif /* SRC_SENSOR_SPI_FRONTEND_H_ */
@@ -0,0 +1,292 @@
+#include "src/Sensor/SensorGroup.h"
+#include "src/MCU/Timer/Timer.h"
+#include <stddef.h>
+
+
+// Stores the responses of the last sync read into the group state, checked ones only
+static void store_sync_registers(TLx49012_Group *group)
+{
+	group->valid = 0;
+
+	for(uint8_t i = 0; i < group->readCount; i++)
+	{
+		const xensiv_rsp_frame_t *frame = &group->readPlan[i].frame;
+		uint8_t slave = group->readPlan[i].slaveSelect;
+
+		// Corrupted read - no new angle
+		if(frame->error != 0)
+		{
+			group->syncRegister[slave].unsignedValue = SYNC_READ_STATUS_MASK;
+			group->errorCount[slave]++;
+			continue;
+		}
+
+		group->syncRegister[slave].unsignedValue = frame->data;
+		group->valid |= (uint8_t)(1U << slave);
+	}
+}
+
+// Counts the freshness of the last sync cycle and adapts the trigger-to-read delay
+static void update_freshness(TLx49012_Group *group)
+{
+	uint8_t checked = group->active & group->valid;
+	uint8_t fresh = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(!(checked & (1U << slave)))
+		{
+			continue;
+		}
+
+		if(group->syncRegister[slave].bitfieldAccess.readStatus)
+		{
+			group->staleCount[slave]++;
+		}
+		else
+		{
+			group->freshCount[slave]++;
+			fresh |= (uint8_t)(1U << slave);
+		}
+	}
+
+	group->syncCount++;
+
+	if(checked != group->active)
+	{
+		group->errorCycles++;
+	}
+
+	if(fresh == group->active)
+	{
+		group->freshCycles++;
+
+		// Probe for a shorter delay once in a while
+		if(++group->freshRun >= TLX49012_SYNC_PROBE_CYCLES)
+		{
+			group->freshRun = 0;
+			if(group->readDelayUs > TLX49012_SYNC_DELAY_DOWN_US)
+			{
+				group->readDelayUs -= TLX49012_SYNC_DELAY_DOWN_US;
+			}
+			else
+			{
+				group->readDelayUs = 0;
+			}
+		}
+		return;
+	}
+
+	if(fresh == 0)
+	{
+		group->staleCycles++;
+	}
+	else
+	{
+		group->partialCycles++;
+	}
+
+	// Only dropped reads missing - they say nothing about the delay
+	if(fresh == checked)
+	{
+		return;
+	}
+
+	// Read came too early for at least one sensor
+	group->freshRun = 0;
+	if(group->readDelayUs < (TLX49012_SYNC_DELAY_MAX_US - TLX49012_SYNC_DELAY_UP_US))
+	{
+		group->readDelayUs += TLX49012_SYNC_DELAY_UP_US;
+	}
+	else
+	{
+		group->readDelayUs = TLX49012_SYNC_DELAY_MAX_US;
+	}
+}
+
+static void sync_read_complete(PSC3M5_SPI_Transaction *transaction)
+{
+	TLx49012_Group *group = (TLx49012_Group *)transaction->context;
+
+	store_sync_registers(group);
+	update_freshness(group);
+
+	group->readPending = false;
+
+	if(group->callback != NULL)
+	{
+		group->callback(group);
+	}
+}
+
+// Delay timer expired - queues the sync read of the whole group, from the timer interrupt
+static void sync_read_start(void *context)
+{
+	TLx49012_Group *group = (TLx49012_Group *)context;
+
+	// SPI queue full - the pulse is lost, as if the previous read was still in progress
+	if(false == PSC3M5_SPI_SubmitPlan(group->readPlan, group->readCount))
+	{
+		group->readPlan[group->readCount - 1].done = true;
+		group->readPending = false;
+		group->busyCount++;
+	}
+}
+
+
+bool TLx49012_GroupInit(TLx49012_Group *group)
+{
+	bool initialized = TLx49012_Init(group->initStatus);
+
+	group->active        = 0;
+	group->valid         = 0;
+	group->syncCount     = 0;
+	group->freshCycles   = 0;
+	group->partialCycles = 0;
+	group->staleCycles   = 0;
+	group->errorCycles   = 0;
+	group->busyCount     = 0;
+	group->readDelayUs   = TLX49012_SYNC_DELAY_START_US;
+	group->freshRun      = 0;
+	group->readCount     = 0;
+	group->callback      = NULL;
+	group->readPending   = false;
+	group->alignTime     = 0;
+	group->angleReads    = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		// No angle captured yet
+		group->syncRegister[slave].unsignedValue = SYNC_READ_STATUS_MASK;
+		group->freshCount[slave]   = 0;
+		group->staleCount[slave]   = 0;
+		group->errorCount[slave]   = 0;
+		group->angle[slave]        = 0;
+		group->angleTime[slave]    = 0;
+		group->velocity[slave]     = 0;
+		group->alignedAngle[slave] = 0;
+
+		// Sensors that failed initialization stay out of the sync reads
+		if(group->initStatus[slave] == TLX49012_INIT_OK)
+		{
+			group->active |= (uint8_t)(1U << slave);
+
+			group->readPlan[group->readCount].slaveSelect = slave;
+			group->readPlan[group->readCount].txFrame     = g_TLx49012_ReadFrameCache[1][ANGLE_SYNC_ADDR];
+			group->readPlan[group->readCount].callback    = NULL;
+			group->readPlan[group->readCount].context     = group;
+
+			group->anglePlan[group->readCount]             = group->readPlan[group->readCount];
+			group->anglePlan[group->readCount].txFrame     = g_TLx49012_ReadFrameCache[1][ANGLE_PRED_ADDR];
+			group->readCount++;
+		}
+	}
+
+	return initialized;
+}
+
+bool TLx49012_GroupSync(TLx49012_Group *group, TLx49012_GroupCallback callback)
+{
+	if(group->readCount == 0)
+	{
+		return false;
+	}
+
+	if(group->readPending)
+	{
+		group->busyCount++;
+		return false;
+	}
+
+	group->callback    = callback;
+	group->readPending = true;
+	group->readPlan[group->readCount - 1].callback = &sync_read_complete;
+
+	// Pending from the pulse on, not only once queued - TLx49012_GroupReadSync() waits for it
+	group->readPlan[group->readCount - 1].done = false;
+
+	// One pulse latches the angle of all sensors at the same time
+	TLx49012_TriggerSyncPin();
+
+	// Read once the sensors have latched, no SPI traffic or CPU time until then
+	if(false == PSC3M5_Timer_Start(group->readDelayUs, &sync_read_start, group))
+	{
+		group->readPlan[group->readCount - 1].done = true;
+		group->readPending = false;
+		group->busyCount++;
+		return false;
+	}
+
+	return true;
+}
+
+void TLx49012_GroupReadSync(TLx49012_Group *group)
+{
+	if(group->readCount == 0)
+	{
+		return;
+	}
+
+	// Let a background read finish first, the plan is shared
+	if(group->readPending)
+	{
+		PSC3M5_SPI_Wait(&group->readPlan[group->readCount - 1]);
+	}
+
+	group->readPlan[group->readCount - 1].callback = NULL;
+	TLx49012_SPI_SendPlan(group->readPlan, group->readCount);
+
+	store_sync_registers(group);
+}
+
+void TLx49012_GroupReadAngles(TLx49012_Group *group)
+{
+	PSC3M5_SPI_Transaction *plan = group->anglePlan;
+
+	if(group->readCount == 0)
+	{
+		return;
+	}
+
+	TLx49012_SPI_SendPlan(plan, group->readCount);
+
+	group->alignTime = plan[0].timestamp;
+	group->valid     = 0;
+
+	for(uint8_t i = 0; i < group->readCount; i++)
+	{
+		uint8_t slave  = plan[i].slaveSelect;
+		uint16_t angle = plan[i].frame.data;
+		int32_t skew;
+
+		// Corrupted read - previous angle, time and velocity kept
+		if(plan[i].frame.error != 0)
+		{
+			group->errorCount[slave]++;
+			continue;
+		}
+		group->valid |= (uint8_t)(1U << slave);
+
+		// Shortest way round since the previous read, over the time between both
+		if(group->angleReads != 0)
+		{
+			int16_t turned   = (int16_t)(angle - group->angle[slave]);
+			uint32_t elapsed = plan[i].timestamp - group->angleTime[slave];
+
+			// Above half a LSB per tick the read rate aliases anyway
+			if(elapsed > (uint32_t)(turned < 0 ? -2 * turned : 2 * turned))
+			{
+				group->velocity[slave] = (int32_t)(((int64_t)turned * ((int64_t)1 << 32)) / elapsed);
+			}
+		}
+
+		group->angle[slave]     = angle;
+		group->angleTime[slave] = plan[i].timestamp;
+
+		// Back to the first read, one or more frames earlier
+		skew = (int32_t)(group->alignTime - plan[i].timestamp);
+		group->alignedAngle[slave] = (uint16_t)(angle + (int16_t)(((int64_t)group->velocity[slave] * skew) >> 32));
+	}
+
+	group->angleReads++;
+}
@@ -0,0 +1,131 @@
+#ifndef SRC_SENSOR_SENSORGROUP_H_
+#define SRC_SENSOR_SENSORGROUP_H_
+
+
+#include "stdint.h"
+#include "stdbool.h"
+#include "src/Sensor/TLx49012.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Trigger-to-read delay: wait between the SYNC pulse and the first sync read. Adapted every
+// cycle - a cycle with a stale sensor adds UP, TLX49012_SYNC_PROBE_CYCLES fresh cycles in a
+// row remove DOWN to probe for a shorter delay. Both steps 0 keep the start value.
+#define TLX49012_SYNC_DELAY_START_US	(50U)
+#define TLX49012_SYNC_DELAY_MAX_US		(1000U)
+#define TLX49012_SYNC_DELAY_UP_US		(8U)
+#define TLX49012_SYNC_DELAY_DOWN_US		(1U)
+#define TLX49012_SYNC_PROBE_CYCLES		(16U)
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+typedef struct TLx49012_Group TLx49012_Group;
+
+// Completion of TLx49012_GroupSync(), called from interrupt context
+typedef void (*TLx49012_GroupCallback)(const TLx49012_Group *group);
+
+// All sensors on the SPI bus. Per-sensor state is kept in struct-of-arrays layout,
+// one array per field indexed by slave select, so a pass over one field of the
+// whole group reads contiguous memory.
+struct TLx49012_Group
+{
+	// Per sensor
+	TLx49012_InitStatus initStatus[TLX49012_SENSOR_COUNT];	// Result of TLx49012_Init()
+	AngleSyncRegister syncRegister[TLX49012_SENSOR_COUNT];	// Last sync register read
+	uint32_t freshCount[TLX49012_SENSOR_COUNT];				// Sync cycles with readStatus clear - new angle
+	uint32_t staleCount[TLX49012_SENSOR_COUNT];				// Sync cycles with readStatus set - no new angle
+	uint32_t errorCount[TLX49012_SENSOR_COUNT];				// Reads dropped, response failed the CRC or status check
+	uint16_t angle[TLX49012_SENSOR_COUNT];					// Last predicted angle read
+	uint32_t angleTime[TLX49012_SENSOR_COUNT];				// Its timestamp, PSC3M5_SPI_PortNow() clock
+	int32_t velocity[TLX49012_SENSOR_COUNT];				// Angle LSB per 2^32 timestamp ticks
+	uint16_t alignedAngle[TLX49012_SENSOR_COUNT];			// Angle projected to alignTime
+
+	// Group
+	uint8_t active;											// Sensors taking part in sync reads, bit n for slave select n
+	uint8_t valid;											// Active sensors whose last read passed the response check
+	uint32_t syncCount;										// Sync cycles completed
+	uint32_t freshCycles;									// Cycles with all active sensors fresh
+	uint32_t partialCycles;									// Cycles with some active sensors fresh
+	uint32_t staleCycles;									// Cycles with no active sensor fresh
+	uint32_t errorCycles;									// Cycles with a read dropped, counted as not fresh
+	uint32_t busyCount;										// Sync pulses skipped or lost, previous read still in progress or SPI queue full
+
+	// Trigger-to-read delay controller
+	uint16_t readDelayUs;									// Current delay, PSC3M5_Timer_Start() from the pulse to the read
+	uint8_t freshRun;										// Fresh cycles in a row since the last change
+
+	// Sync read of the active sensors, one transaction each, queued back to back
+	PSC3M5_SPI_Transaction readPlan[TLX49012_SENSOR_COUNT];
+	uint8_t readCount;
+	TLx49012_GroupCallback callback;
+	volatile bool readPending;
+
+	// Predicted angle read of the active sensors, without SYNC
+	PSC3M5_SPI_Transaction anglePlan[TLX49012_SENSOR_COUNT];
+	uint32_t alignTime;										// Common time of alignedAngle[], the first read
+	uint32_t angleReads;									// TLx49012_GroupReadAngles() calls
+};
+
+
+/*******************************************************************************
+ * Function Name: TLx49012_GroupInit
+ ***************************************************************************//**
+ * \brief  	Initializes all TLX49012_SENSOR_COUNT sensors with TLx49012_Init()
+ *			and builds the sync read plan of those that passed. Counters are
+ *			cleared, all sync registers start out stale and the trigger-to-read
+ *			delay starts at TLX49012_SYNC_DELAY_START_US.
+ * \param  	group	Sensor group.
+ * \return 	true if all sensors are initialized.
+ ******************************************************************************/
+bool TLx49012_GroupInit(TLx49012_Group *group);
+
+/*******************************************************************************
+ * Function Name: TLx49012_GroupSync
+ ***************************************************************************//**
+ * \brief  	Sends one SYNC pulse to the whole group, starts the delay timer
+ *			and returns immediately. readDelayUs after the pulse the timer
+ *			queues the sync register reads of all active sensors as one
+ *			batch, see PSC3M5_Timer_Start() for boards without a timer.
+ *			Once the last response is in, the freshness counters and the
+ *			delay are updated and the callback runs. A sensor whose response
+ *			fails the check reads as readStatus set, is counted in errorCount
+ *			and leaves the delay alone.
+ * \param  	group		Sensor group.
+ * \param  	callback	Completion callback, called from interrupt context.
+ * \return 	false if the previous read is still in progress (no pulse sent,
+ *			counted in busyCount) or no sensor is active. A read that finds
+ *			the SPI queue full is dropped and counted in busyCount as well.
+ ******************************************************************************/
+bool TLx49012_GroupSync(TLx49012_Group *group, TLx49012_GroupCallback callback);
+
+/*******************************************************************************
+ * Function Name: TLx49012_GroupReadAngles
+ ***************************************************************************//**
+ * \brief  	Reads the predicted angle of all active sensors with a single
+ *			transaction plan, without SYNC pulse, and waits for the result.
+ *			The reads follow each other one SPI frame apart, so each angle
+ *			is projected to the time of the first read with the velocity
+ *			of its sensor. The velocity comes from the previous call and is
+ *			0 before the second one; it aliases above half a turn per call.
+ *			A sensor whose response fails the check keeps its previous
+ *			values and is cleared in valid.
+ * \param  	group	Sensor group, angle[] and alignedAngle[] updated on return.
+ ******************************************************************************/
+void TLx49012_GroupReadAngles(TLx49012_Group *group);
+
+/*******************************************************************************
+ * Function Name: TLx49012_GroupReadSync
+ ***************************************************************************//**
+ * \brief  	Reads the sync register of all active sensors in one SPI
+ *			transaction plan and waits for the result. No SYNC pulse is sent,
+ *			nor are the freshness counters updated.
+ * \param  	group	Sensor group, syncRegister updated on return.
+ ******************************************************************************/
+void TLx49012_GroupReadSync(TLx49012_Group *group);
+
+
+#endif /* SRC_SENSOR_SENSORGROUP_H_ */
@@ -0,0 +1,303 @@
+#include "src/Sensor/TLx49012.h"
+#include "src/Sensor/ConfigShadow.h"
+#include "src/Sensor/ConfigImage.h"
+#include "stdio.h"
+
+// Simulated sensors have no pins and a simulated clock - no PDL on a host
+#ifndef PSC3M5_SPI_BACKEND_SIM
+#include "cy_gpio.h"
+#include "cy_utils.h"
+#include "cycfg_pins.h"
+#include "cy_syslib.h"
+#endif
+
+
+// Constant initialization commands - frames and CRCs are built at compile time
+static const uint8_t unlock_frame[4]			= TLX49012_WRITE_FRAME(UNLOCK_REG_ADDR, USR_PASS_DATA);
+static const uint8_t crc_bm_disable_frame[4]	= TLX49012_WRITE_FRAME(STAT_EN_1_REG_ADDR, CRC_BM_DIS_DATA);
+static const uint8_t soft_reset_vm_frame[4]		= TLX49012_WRITE_FRAME(STAT_EN_REG_ADDR, VAL_SOFT_RESET_VM_DATA);
+
+// Initialization sequence - each step runs on all sensors that passed the previous ones
+typedef enum
+{
+	INIT_STEP_WAIT_READY,		// Poll with the frame until SPI is active
+	INIT_STEP_SEND,				// Send the frame, response ignored
+	INIT_STEP_VERIFY,			// Send the read frame and check the register content
+	INIT_STEP_CONFIGURE,		// Write init_config where the shadow differs
+	INIT_STEP_CONFIGURE_IMAGE,	// Burst write the build-time image of the whole user configuration area
+	INIT_STEP_CONFIG_VERIFY		// Read back the registers written, one plan
+} init_step_type;
+
+typedef struct
+{
+	init_step_type type;
+	const char *message;			// Progress message, NULL if none
+	const uint8_t *frame;			// Command frame
+	uint16_t expected;				// INIT_STEP_VERIFY: expected register content
+	TLx49012_InitStatus failure;	// Reported for sensors failing the step
+	const char *error;				// Failure message
+} init_step;
+
+static const init_step init_sequence[] =
+{
+	// Wait for SPI to become active - ASSUME JUST POWERED ON
+	{ INIT_STEP_WAIT_READY, NULL, g_TLx49012_ReadFrameCache[0][STAT_EN_REG_ADDR], 0, TLX49012_INIT_NOT_READY, "not ready after power-on" },
+	// Unlock sensors
+	{ INIT_STEP_SEND, "Unlocking sensors...\r\n", unlock_frame, 0, TLX49012_INIT_OK, NULL },
+	// Disable Bitmap CRC checks
+	{ INIT_STEP_SEND, "Disabling CRC checks for bitmaps...\r\n", crc_bm_disable_frame, 0, TLX49012_INIT_OK, NULL },
+	// Test sensors responses
+	{ INIT_STEP_VERIFY, NULL, g_TLx49012_ReadFrameCache[1][STAT_EN_1_REG_ADDR], CRC_BM_DIS_DATA, TLX49012_INIT_LOCKED, "not responding or locked" },
+	// Soft configure sensors
+#if TLX49012_CONFIG_IMAGE_ENABLE
+	{ INIT_STEP_CONFIGURE_IMAGE, "Configuring sensors...\r\n", NULL, 0, TLX49012_INIT_OK, NULL },
+#else
+	{ INIT_STEP_CONFIGURE, "Configuring sensors...\r\n", NULL, 0, TLX49012_INIT_OK, NULL },
+#endif
+	// Reset sensor from VM memory - keep and apply configuration
+	{ INIT_STEP_SEND, "Reseting sensors...\r\n", soft_reset_vm_frame, 0, TLX49012_INIT_OK, NULL },
+	// Wait for SPI to become active
+	{ INIT_STEP_WAIT_READY, NULL, g_TLx49012_ReadFrameCache[0][STAT_EN_REG_ADDR], 0, TLX49012_INIT_NOT_READY, "not ready after reset" },
+	// Configuration check after reset
+	{ INIT_STEP_CONFIG_VERIFY, NULL, NULL, 0, TLX49012_INIT_NOT_CONFIGURED, "not configured correctly" },
+	// Clear SYNC registers
+	{ INIT_STEP_SEND, NULL, g_TLx49012_ReadFrameCache[1][ANGLE_SYNC_ADDR], 0, TLX49012_INIT_OK, NULL }
+};
+
+#define INIT_STEP_COUNT		(sizeof(init_sequence) / sizeof(init_sequence[0]))
+
+#if !TLX49012_CONFIG_IMAGE_ENABLE
+// User configuration applied by TLx49012_Init(), see ConfigImage.h for the whole area
+static const TLx49012_RegisterValue init_config[] =
+{
+	// SPI + SYNC ON IFE + FALLING EDGE SYNC
+	{ USR_CONFIG_1_ADDR, USR_CONFIG_1_DATA }
+};
+
+#define INIT_CONFIG_COUNT	(sizeof(init_config) / sizeof(init_config[0]))
+#endif
+
+// Sends the same frame to the selected sensors in one plan, responses indexed by slave select
+static void send_frame_to_sensors(const uint8_t *frame, uint8_t sensors, xensiv_rsp_frame_t responses[TLX49012_SENSOR_COUNT])
+{
+	PSC3M5_SPI_Transaction plan[TLX49012_SENSOR_COUNT] = { 0 };
+	uint8_t count = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(sensors & (1U << slave))
+		{
+			plan[count].slaveSelect = slave;
+			plan[count].txFrame     = frame;
+			count++;
+		}
+	}
+
+	TLx49012_SPI_SendPlan(plan, count);
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		responses[plan[i].slaveSelect] = plan[i].frame;
+	}
+}
+
+// Polls the selected sensors until SPI is active, returns the ready ones
+static uint8_t wait_ready(const uint8_t *frame, uint8_t sensors)
+{
+	xensiv_rsp_frame_t responses[TLX49012_SENSOR_COUNT];
+	uint8_t ready = 0;
+	uint8_t pending;
+
+	// Frame time not counted - the timeout only errs on the long side
+	for(uint32_t waited = 0; ; waited += TLX49012_READY_POLL_US)
+	{
+		pending = sensors & (uint8_t)~ready;
+		send_frame_to_sensors(frame, pending, responses);
+
+		for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			// Until SPI is active MISO is not driven - all 0s/1s never carry a valid CRC
+			if((pending & (1U << slave)) && !(responses[slave].error & XENSIV_RSP_ERROR_CRC))
+			{
+				ready |= (uint8_t)(1U << slave);
+			}
+		}
+
+		if((ready == sensors) || (waited >= TLX49012_READY_TIMEOUT_US))
+		{
+			return ready;
+		}
+
+#ifdef PSC3M5_SPI_BACKEND_SIM
+		PSC3M5_SPI_SimElapseUs(TLX49012_READY_POLL_US);
+#else
+		Cy_SysLib_DelayUs(TLX49012_READY_POLL_US);
+#endif
+	}
+}
+
+
+bool TLx49012_Init(TLx49012_InitStatus status[TLX49012_SENSOR_COUNT])
+{
+	xensiv_rsp_frame_t responses[TLX49012_SENSOR_COUNT];
+	uint8_t active = TLX49012_ALL_SENSORS;	// Sensors that passed all steps so far
+	uint8_t passed;
+
+	printf("Sensor initializations in progress...\r\n");
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		status[slave] = TLX49012_INIT_OK;
+	}
+
+	// ASSUME JUST POWERED ON - register contents unknown
+	TLx49012_ShadowInvalidate(TLX49012_ALL_SENSORS);
+
+	for(uint8_t i = 0; (i < INIT_STEP_COUNT) && (active != 0); i++)
+	{
+		const init_step *step = &init_sequence[i];
+
+		if(step->message != NULL)
+		{
+			printf("%s", step->message);
+		}
+
+		passed = active;
+
+		switch(step->type)
+		{
+			case INIT_STEP_WAIT_READY:
+				passed = wait_ready(step->frame, active);
+				break;
+
+			case INIT_STEP_VERIFY:
+				send_frame_to_sensors(step->frame, active, responses);
+				for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+				{
+					if((active & (1U << slave)) && ((responses[slave].error != 0) || (responses[slave].data != step->expected)))
+					{
+						passed &= (uint8_t)~(1U << slave);
+					}
+				}
+				break;
+
+#if TLX49012_CONFIG_IMAGE_ENABLE
+			case INIT_STEP_CONFIGURE_IMAGE:
+				// Image and block CRC are constant - no read back, no CRC at run time
+				TLx49012_ShadowWriteArea(g_TLx49012_ConfigImage, g_TLx49012_ConfigImageFrames, active);
+				break;
+#else
+			case INIT_STEP_CONFIGURE:
+				for(uint8_t j = 0; j < INIT_CONFIG_COUNT; j++)
+				{
+					TLx49012_ShadowWrite(init_config[j].addr, init_config[j].data, active);
+				}
+				break;
+#endif
+
+			case INIT_STEP_CONFIG_VERIFY:
+				passed = TLx49012_ShadowVerify(active);
+				break;
+
+			default:
+				send_frame_to_sensors(step->frame, active, responses);
+				break;
+		}
+
+		// Report failing sensors and leave them out - the others carry on
+		for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			if((active & (uint8_t)~passed) & (1U << slave))
+			{
+				status[slave] = step->failure;
+				printf("ERROR: Sensor%u %s\r\n", slave, step->error);
+			}
+		}
+
+		active = passed;
+	}
+
+	// Readiness polls fail the response check by design - count from here on
+	PSC3M5_SPI_ClearFrameErrors();
+
+	printf("Sensor initializations DONE!\r\n");
+
+	return (active == TLX49012_ALL_SENSORS);
+}
+
+uint8_t TLx49012_Configure(const TLx49012_RegisterValue *config, uint8_t count, uint8_t sensors)
+{
+	xensiv_rsp_frame_t responses[TLX49012_SENSOR_COUNT];
+	uint8_t changed = 0;
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		changed |= TLx49012_ShadowDiffers(config[i].addr, config[i].data, sensors);
+	}
+
+	// Configuration already in place - no SPI traffic
+	if(changed == 0)
+	{
+		return sensors;
+	}
+
+	send_frame_to_sensors(unlock_frame, changed, responses);
+	send_frame_to_sensors(crc_bm_disable_frame, changed, responses);
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		TLx49012_ShadowWrite(config[i].addr, config[i].data, changed);
+	}
+
+	return (sensors & (uint8_t)~changed) | TLx49012_ShadowVerify(changed);
+}
+
+bool TLx49012_GetAngleLSB(uint16_t *angleLSB, uint8_t slaveSelect)
+{
+	xensiv_rsp_frame_t sensor_response;
+	
+	sensor_response = TLx49012_SPI_ReadInFrameChecked(ANGLE_PRED_ADDR, true, slaveSelect);
+
+	if(sensor_response.error != 0)
+	{
+		return false;
+	}
+
+	*angleLSB = sensor_response.data;
+
+	return true;
+}
+
+AngleSyncRegister TLx49012_GetAngleSyncRegister(uint8_t slaveSelect)
+{
+	xensiv_rsp_frame_t sensor_response;
+	AngleSyncRegister sync_register;
+
+	sensor_response = TLx49012_SPI_ReadInFrameChecked(ANGLE_SYNC_ADDR, true, slaveSelect);
+	sync_register.unsignedValue = sensor_response.data;
+
+	// Corrupted read - no new angle
+	if(sensor_response.error != 0)
+	{
+		sync_register.unsignedValue = SYNC_READ_STATUS_MASK;
+	}
+	
+	return sync_register;
+}
+
+void TLx49012_TriggerSyncPin(void)
+{
+#ifdef PSC3M5_SPI_BACKEND_SIM
+	// Simulated sensors capture on the edge, the pulse takes no simulated time
+	PSC3M5_SPI_SimSyncEdge();
+#elif defined(SYNC_PIN_PORT)
+	Cy_GPIO_Write(SYNC_PIN_PORT, SYNC_PIN_NUM, 0);
+	Cy_SysLib_DelayUs(TLX49012_SYNC_PULSE_US);
+	Cy_GPIO_Write(SYNC_PIN_PORT, SYNC_PIN_NUM, 1);
+#else
+	// No SYNC_PIN in the device configuration of this board
+	CY_ASSERT(0);
+#endif
+}
+
+
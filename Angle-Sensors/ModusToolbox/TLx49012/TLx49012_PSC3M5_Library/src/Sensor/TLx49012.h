@@ -8,6 +8,11 @@
 /*------------------------------------------CONFIGURABLE PARAMETERS--------------------------------------------------*/
 /*********************************************************************************************************************/
 
+// Sensors sharing the SPI bus, one slave select each starting at SPI_SLAVE0 - up to SPI_SLAVE_SELECT_COUNT
+#ifndef TLX49012_SENSOR_COUNT
+#define TLX49012_SENSOR_COUNT			2
+#endif
+
 /*********************************************************************************************************************/
 /*------------------------------------------------------Macros-------------------------------------------------------*/
 /*********************************************************************************************************************/
@@ -45,6 +50,20 @@
 // Sensor Slaves
 #define SPI_SLAVE0						0
 #define SPI_SLAVE1						1
+#define SPI_SLAVE2						2
+#define SPI_SLAVE3						3
+#define TLX49012_ALL_SENSORS			((uint8_t)((1U << TLX49012_SENSOR_COUNT) - 1U))
+
+#if (TLX49012_SENSOR_COUNT < 1) || (TLX49012_SENSOR_COUNT > SPI_SLAVE_SELECT_COUNT)
+#error "TLX49012_SENSOR_COUNT must be between 1 and SPI_SLAVE_SELECT_COUNT"
+#endif
+
+// SYNC pulse, falling edge triggers the capture
+#define TLX49012_SYNC_PULSE_US			(5U)
+
+// Readiness polling after power-on and soft reset, replaces the worst-case waits
+#define TLX49012_READY_POLL_US			(10U)
+#define TLX49012_READY_TIMEOUT_US		(2000U)
 
 /*********************************************************************************************************************/
 /*-------------------------------------------------Data Structures---------------------------------------------------*/
@@ -62,30 +81,73 @@ typedef struct
 typedef union
 {
     AngleSyncRegisterStructure bitfieldAccess;           /* brief Bit field access */
-    uint16 unsignedValue;               				 /* brief Unsigned access */
+    uint16_t unsignedValue;               				 /* brief Unsigned access */
 } AngleSyncRegister;
 
+// Per-sensor result of TLx49012_Init()
+typedef enum
+{
+	TLX49012_INIT_OK = 0,
+	TLX49012_INIT_NOT_READY,		// SPI not active within TLX49012_READY_TIMEOUT_US
+	TLX49012_INIT_LOCKED,			// Not responding or locked, unlock not confirmed
+	TLX49012_INIT_NOT_CONFIGURED	// Configuration not applied after reset
+} TLx49012_InitStatus;
+
+// One register of a configuration, see TLx49012_Configure()
+typedef struct
+{
+	uint8_t addr;
+	uint16_t data;
+} TLx49012_RegisterValue;
+
 
 /*******************************************************************************
  * Function Name: TLx49012_Init
  ***************************************************************************//**
- * \brief 	Initializes the sensor through a series of SPI commands.
-		  	Soft-resets the sensor.
+ * \brief 	Initializes all sensors through a series of SPI commands, each step
+ *			sent to all sensors back to back. Soft-resets the sensors and polls
+ *			them for readiness instead of waiting the worst case. A sensor
+ *			failing a step is reported and left out of the following steps,
+ *			the others carry on. With TLX49012_CONFIG_IMAGE_ENABLE the whole
+ *			user configuration area is written from the build-time image of
+ *			ConfigImage.h, block CRC included, in one burst.
+ * \param  	status	Per-sensor result, indexed by slave select.
+ * \return 	true if all sensors are initialized.
+ ******************************************************************************/
+bool TLx49012_Init(TLx49012_InitStatus status[TLX49012_SENSOR_COUNT]);
+
+/*******************************************************************************
+ * Function Name: TLx49012_Configure
+ ***************************************************************************//**
+ * \brief  	Applies a user configuration at run time. Only registers that
+ *			differ from the configuration shadow are written, so sensors with
+ *			nothing to change see no SPI traffic. Sensors with changes are
+ *			unlocked first, and all written registers are read back in one plan.
+ *			Settings applied on reset need a soft reset from VM afterwards.
+ * \param  	config		Registers and data, user configuration area (0x3F-0x4D).
+ * \param  	count		Number of registers.
+ * \param  	sensors		Sensor mask, bit n for slave select n.
+ * \return 	Sensors holding the configuration.
  ******************************************************************************/
-void TLx49012_Init(void);
+uint8_t TLx49012_Configure(const TLx49012_RegisterValue *config, uint8_t count, uint8_t sensors);
 
 /*******************************************************************************
  * Function Name: TLx49012_GetAngleLSB
  ***************************************************************************//**
  * \brief  	Reads the internal register at configured address via SPI.
- * \return 	Angle value in LSB, 16-bit.
+ *			A response failing the CRC or status check is dropped.
+ * \param  	angleLSB	Angle value in LSB, 16-bit, left unchanged on error.
+ * \param  	slaveSelect	SPI slave select.
+ * \return 	false if the response failed the check.
  ******************************************************************************/
-uint16_t TLx49012_GetAngleLSB(uint8_t slaveSelect);
+bool TLx49012_GetAngleLSB(uint16_t *angleLSB, uint8_t slaveSelect);
 
 /*******************************************************************************
  * Function Name: TLx49012_GetAngleSyncRegister
  ***************************************************************************//**
  * \brief  	Reads the internal register at configured address via SPI.
+ *			A response failing the CRC or status check reads as readStatus
+ *			set, i.e. no new angle.
  * \return 	Register value of type AngleSyncRegister
  ******************************************************************************/
 AngleSyncRegister TLx49012_GetAngleSyncRegister(uint8_t slaveSelect);
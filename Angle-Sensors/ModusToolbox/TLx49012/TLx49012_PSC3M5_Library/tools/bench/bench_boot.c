@@ -0,0 +1,127 @@
+// Boot-to-first-sample on the simulated sensors: TLx49012_GroupInit() with readiness
+// polling, then sync cycles until every active sensor has a fresh angle. Time is the
+// simulated time: wire time of the frames, poll and trigger-to-read delays.
+//
+// The simulated sensors boot in frames, not in time - each ignored frame stands for one
+// poll. The former fixed-delay initialization is replayed for comparison with sensors
+// that are up at once: its frames and its 550us and 900us waits, then the same first
+// sync cycle as the polled run.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include <stdio.h>
+
+
+static TLx49012_Group group;
+
+static const uint16_t boot_frames[] = { 0U, 4U, 16U, 64U };
+
+
+static void set_boot_frames(uint16_t frames, uint16_t lastSensorFrames)
+{
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		PSC3M5_SPI_SimSetBootFrames(slave, (slave == (TLX49012_SENSOR_COUNT - 1U)) ? lastSensorFrames : frames);
+	}
+}
+
+// Sync cycles until all active sensors read fresh, simulated us
+static uint32_t first_sample(void)
+{
+	uint32_t start    = PSC3M5_SPI_SimTimeUs();
+	uint32_t previous = group.freshCycles;
+
+	while((group.active != 0) && (group.freshCycles == previous))
+	{
+		(void)TLx49012_GroupSync(&group, NULL);
+		while(group.readPending)
+		{
+			PSC3M5_SPI_Wait(&group.readPlan[group.readCount - 1]);
+		}
+	}
+
+	return PSC3M5_SPI_SimTimeUs() - start;
+}
+
+// Former TLx49012_Init(): each frame to one sensor after the other, 1us apart, fixed waits
+static void send_to_all(const uint8_t *frame)
+{
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(slave != 0)
+		{
+			PSC3M5_SPI_SimElapseUs(1U);
+		}
+		(void)TLx49012_SPI_SendFrame(frame, slave);
+	}
+}
+
+static uint32_t fixed_delay_init(void)
+{
+	static const uint8_t unlock_frame[4]		= TLX49012_WRITE_FRAME(UNLOCK_REG_ADDR, USR_PASS_DATA);
+	static const uint8_t crc_bm_disable_frame[4]	= TLX49012_WRITE_FRAME(STAT_EN_1_REG_ADDR, CRC_BM_DIS_DATA);
+	static const uint8_t usr_config_1_frame[4]	= TLX49012_WRITE_FRAME(USR_CONFIG_1_ADDR, USR_CONFIG_1_DATA);
+	static const uint8_t soft_reset_vm_frame[4]	= TLX49012_WRITE_FRAME(STAT_EN_REG_ADDR, VAL_SOFT_RESET_VM_DATA);
+	uint32_t start = PSC3M5_SPI_SimTimeUs();
+
+	PSC3M5_SPI_SimElapseUs(550U);
+	send_to_all(unlock_frame);
+	send_to_all(crc_bm_disable_frame);
+	send_to_all(g_TLx49012_ReadFrameCache[1][STAT_EN_1_REG_ADDR]);
+	send_to_all(usr_config_1_frame);
+	send_to_all(soft_reset_vm_frame);
+	PSC3M5_SPI_SimElapseUs(900U);
+	send_to_all(g_TLx49012_ReadFrameCache[1][USR_CONFIG_1_ADDR]);
+	send_to_all(g_TLx49012_ReadFrameCache[1][ANGLE_SYNC_ADDR]);
+
+	return PSC3M5_SPI_SimTimeUs() - start;
+}
+
+static uint32_t run(const char *init, uint16_t frames, uint16_t lastSensorFrames)
+{
+	uint32_t start;
+	uint32_t init_us;
+	uint32_t sample_us;
+
+	set_boot_frames(frames, lastSensorFrames);
+
+	start = PSC3M5_SPI_SimTimeUs();
+	(void)TLx49012_GroupInit(&group);
+	init_us   = PSC3M5_SPI_SimTimeUs() - start;
+	sample_us = first_sample();
+
+	printf("BOOT,%s,%u,%u,%02X,%lu,%lu\r\n", init, frames, lastSensorFrames, group.active,
+		   (unsigned long)init_us, (unsigned long)(init_us + sample_us));
+
+	return sample_us;
+}
+
+
+int main(void)
+{
+	uint32_t sample_us = 0;
+	uint32_t init_us;
+
+	PSC3M5_MCU_Init();
+
+	printf("BOOT,init,boot_frames,last_sensor_boot_frames,active,init_us,first_sample_us\r\n");
+
+	for(uint8_t i = 0; i < (sizeof(boot_frames) / sizeof(boot_frames[0])); i++)
+	{
+		uint32_t us = run("polled", boot_frames[i], boot_frames[i]);
+
+		if(i == 0)
+		{
+			sample_us = us;
+		}
+	}
+
+	// One sensor never comes up - the others wait for its timeout only
+	(void)run("polled", 0U, PSC3M5_SPI_SIM_NEVER_BOOTS);
+
+	set_boot_frames(0U, 0U);
+	init_us = fixed_delay_init();
+	printf("BOOT,fixed,0,0,%02X,%lu,%lu\r\n", TLX49012_ALL_SENSORS, (unsigned long)init_us, (unsigned long)(init_us + sample_us));
+
+	return 0;
+}
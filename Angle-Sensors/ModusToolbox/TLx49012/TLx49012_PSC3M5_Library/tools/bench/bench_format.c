@@ -0,0 +1,129 @@
+// Angle line formatting: PSC3M5_UART_FormatAngleInfo() with the integer milli-degree macros
+// against the former path of UART.c - double arithmetic and printf("%.3f"), several printf()
+// calls per line, one per hex padding character of the 16-bit angle. The former calls are
+// replayed with snprintf() into a buffer, so that both paths time the formatting only.
+// Every 14-bit sync angle is first checked to give the former text, but for the half-way
+// ties where printf() rounds half to even and the integer path half up.
+
+#include "src/MCU/UART/UART.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_LINES		(2000000U)
+
+
+static volatile uint32_t sink;		// Keeps the lines from being optimized away
+
+
+// Former PSC3M5_UART_SendAngleInfo(), 16-bit angle
+static uint8_t former_angle_info(char *line, uint16_t angle, uint8_t slave)
+{
+	int length = 0;
+	double angle_deg;
+
+	length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "Sensor%u ->ANGLE [LSB]: 0x", slave);
+
+	if(angle <= 0x0fff)
+		length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "0");
+
+	if(angle <= 0x00ff)
+		length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "0");
+
+	if(angle <= 0x000f)
+		length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "0");
+
+	length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "%X | ", angle);
+
+	angle_deg = ((uint32_t)angle * 360.0) / 65535;
+	length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "Sensor%u ->ANGLE [deg]: %.3f\r\n", slave, angle_deg);
+
+	return (uint8_t)length;
+}
+
+// Former PSC3M5_UART_SendSyncAngleInfo(), 14-bit angle
+static uint8_t former_sync_angle_info(char *line, uint16_t angle, uint8_t slave)
+{
+	int length = 0;
+	double angle_deg;
+
+	length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "Sensor%u ->ANGLE [LSB]: 0x", slave);
+	length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "%04X | ", angle);
+
+	angle_deg = ((uint32_t)angle * 360.0) / 16384; // 14 bit value
+	length += snprintf(line + length, PSC3M5_UART_ANGLE_LINE_MAX - length, "Sensor%u ->ANGLE [deg]: %.3f\r\n", slave, angle_deg);
+
+	return (uint8_t)length;
+}
+
+static uint8_t integer_angle_info(char *line, uint16_t angle, uint8_t slave)
+{
+	return PSC3M5_UART_FormatAngleInfo(line, angle, PSC3M5_ANGLE16_TO_MDEG(angle), slave);
+}
+
+static uint8_t integer_sync_angle_info(char *line, uint16_t angle, uint8_t slave)
+{
+	return PSC3M5_UART_FormatAngleInfo(line, angle, PSC3M5_ANGLE14_TO_MDEG(angle), slave);
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static void run(const char *path, uint16_t angleMask, uint8_t (*format)(char *line, uint16_t angle, uint8_t slave))
+{
+	char line[PSC3M5_UART_ANGLE_LINE_MAX];
+	uint64_t start = now_ns();
+	uint64_t elapsed;
+	uint32_t acc = 0;
+
+	for(uint32_t i = 0; i < BENCH_LINES; i++)
+	{
+		acc += format(line, (uint16_t)((i * 40503U) & angleMask), (uint8_t)(i & 1U));
+	}
+
+	elapsed = now_ns() - start;
+	sink = acc;
+
+	printf("FORMAT,%s,%u,%llu,%.1f\r\n", path, BENCH_LINES, (unsigned long long)elapsed, (double)elapsed / BENCH_LINES);
+}
+
+
+int main(void)
+{
+	char former[PSC3M5_UART_ANGLE_LINE_MAX];
+	char integer[PSC3M5_UART_ANGLE_LINE_MAX];
+	uint32_t ties = 0;
+
+	for(uint16_t angle = 0; angle < 16384U; angle++)
+	{
+		bool tie = (((uint32_t)angle * 360000U) % 16384U) == 8192U;
+
+		former_sync_angle_info(former, angle, 0);
+		integer_sync_angle_info(integer, angle, 0);
+
+		if(0 != strcmp(former, integer))
+		{
+			if(!tie)
+			{
+				printf("ERROR: sync angle 0x%04X: %s", angle, integer);
+				return 1;
+			}
+			ties++;
+		}
+	}
+
+	printf("FORMAT,sync angles differing on half-way ties,%lu\r\n", (unsigned long)ties);
+	printf("FORMAT,path,lines,elapsed_ns,ns_per_line\r\n");
+	run("former16", 0xFFFFU, &former_angle_info);
+	run("integer16", 0xFFFFU, &integer_angle_info);
+	run("former14", 0x3FFFU, &former_sync_angle_info);
+	run("integer14", 0x3FFFU, &integer_sync_angle_info);
+
+	return 0;
+}
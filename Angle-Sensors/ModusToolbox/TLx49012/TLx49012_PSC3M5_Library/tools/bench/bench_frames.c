@@ -0,0 +1,82 @@
+// Read command frames: precomputed cache against frame assembly plus CalcCRC() per call,
+// the path TLx49012_SPI_ReadInFrame() took before SPI_FrameCache.c. Both paths are first
+// checked to give the same 256 frames, then timed over the same address sequence.
+
+#include "src/Sensor/Interface/SPI_FrameCache.h"
+#include "src/Sensor/Interface/CRC8_SAE_J1850.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FRAMES	(10000000U)
+
+
+static volatile uint32_t sink;		// Keeps the frames from being optimized away
+
+
+// Former TLx49012_SPI_ReadInFrame() frame assembly
+static const uint8_t * assemble_read_frame(uint8_t addr, bool clearStatus)
+{
+	static uint8_t data_to_send[4];
+
+	data_to_send[0] = (uint8_t)((addr & 0x7F) << 1);	// 7bit address 1 bit R/W = 0
+	data_to_send[1] = 0x00;								// Unused
+	data_to_send[2] = clearStatus ? 0xFF : 0x00;		// All 1s clear device status bit
+	data_to_send[3] = CalcCRC(data_to_send, 3);
+
+	return data_to_send;
+}
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+static void run(const char *path, const uint8_t * (*get_frame)(uint8_t addr, bool clearStatus))
+{
+	uint64_t start = now_ns();
+	uint64_t elapsed;
+	uint32_t acc = 0;
+
+	for(uint32_t i = 0; i < BENCH_FRAMES; i++)
+	{
+		const uint8_t *frame = get_frame((uint8_t)(i * 37U), (i & 0x100U) != 0);
+
+		acc += frame[0] ^ frame[3];
+	}
+
+	elapsed = now_ns() - start;
+	sink = acc;
+
+	printf("FRAMES,%s,%u,%llu,%.2f\r\n", path, BENCH_FRAMES, (unsigned long long)elapsed, (double)elapsed / BENCH_FRAMES);
+}
+
+static const uint8_t * cached_read_frame(uint8_t addr, bool clearStatus)
+{
+	return TLx49012_GetReadFrame(addr, clearStatus);
+}
+
+
+int main(void)
+{
+	for(uint16_t addr = 0; addr < TLX49012_FRAME_ADDR_COUNT; addr++)
+	{
+		for(uint8_t clear = 0; clear < 2; clear++)
+		{
+			if(0 != memcmp(assemble_read_frame((uint8_t)addr, clear), cached_read_frame((uint8_t)addr, clear), 4))
+			{
+				printf("ERROR: cached frame 0x%02X/%u differs\r\n", addr, clear);
+				return 1;
+			}
+		}
+	}
+
+	printf("FRAMES,path,frames,elapsed_ns,ns_per_frame\r\n");
+	run("assembled", &assemble_read_frame);
+	run("cached", &cached_read_frame);
+
+	return 0;
+}
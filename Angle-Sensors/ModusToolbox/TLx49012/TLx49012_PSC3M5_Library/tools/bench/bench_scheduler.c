@@ -0,0 +1,94 @@
+// Periodic scheduler on the timerfd port of Scheduler_Host.c: period jitter and overruns
+// of PSC3M5_Scheduler_WaitTick() per acquisition rate. Each rate runs one sync cycle of
+// the simulated group per period, then once more with every 100th period running 2.5
+// periods long. The first tick it overlaps is only served late, the second one is missed:
+// each long period must show up as one overrun.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include <stdio.h>
+#include <sys/prctl.h>
+
+#define BENCH_SECONDS		(1U)
+#define BENCH_LONG_EVERY	(100U)		// Periods between two long ones, 0 for none
+
+
+static TLx49012_Group group;
+
+static const uint32_t rates_hz[] = { 1000U, 5000U, 10000U, 20000U };
+
+
+// Keeps the CPU busy for ticks of the scheduler clock
+static void spin(uint32_t ticks)
+{
+	uint32_t start = PSC3M5_Scheduler_Now();
+
+	while((PSC3M5_Scheduler_Now() - start) < ticks)
+	{
+	}
+}
+
+static bool run(uint32_t rateHz, uint32_t longEvery)
+{
+	const PSC3M5_Scheduler_Stats *stats;
+	uint32_t cycles = rateHz * BENCH_SECONDS;
+	uint32_t longs  = 0;
+
+	PSC3M5_Scheduler_Init(rateHz);
+	stats = PSC3M5_Scheduler_GetStats();
+
+	while(stats->cycles < cycles)
+	{
+		PSC3M5_Scheduler_WaitTick();
+
+		TLx49012_GroupSync(&group, NULL);
+		TLx49012_GroupReadSync(&group);
+
+		if((longEvery != 0) && ((stats->cycles % longEvery) == 0))
+		{
+			spin((2U * stats->periodTicks) + (stats->periodTicks / 2U));
+			longs++;
+		}
+	}
+
+	printf("SCHED,%lu,%s,%lu,%lu,%lu,%lu,%lu\r\n",
+		   (unsigned long)rateHz, longEvery ? "long" : "plain", (unsigned long)stats->cycles,
+		   (unsigned long)stats->overruns, (unsigned long)longs,
+		   (unsigned long)(stats->jitterSumTicks / (stats->cycles - 1U)), (unsigned long)stats->jitterMaxTicks);
+
+	// A loaded host can miss more periods - never fewer
+	return stats->overruns >= longs;
+}
+
+
+int main(void)
+{
+	bool ok = true;
+
+	// Default timer slack delays timerfd wakeups by up to 50us - the kernel, not the scheduler
+	prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+	PSC3M5_MCU_Init();
+
+	if(false == TLx49012_GroupInit(&group))
+	{
+		printf("ERROR: simulated sensors not initialized\r\n");
+		return 1;
+	}
+
+	printf("SCHED,rate_hz,load,cycles,overruns,long_periods,jitter_avg_ns,jitter_max_ns\r\n");
+
+	for(uint8_t i = 0; i < (sizeof(rates_hz) / sizeof(rates_hz[0])); i++)
+	{
+		ok &= run(rates_hz[i], 0);
+		ok &= run(rates_hz[i], BENCH_LONG_EVERY);
+	}
+
+	if(!ok)
+	{
+		printf("ERROR: long periods not counted as overruns\r\n");
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,27 @@
+// Host driver of the SPI transport benchmark, see Section 5 of the library README.
+// Runs PSC3M5_Bench_Run() against the simulated sensors: one BENCH line per
+// workload and SCLK rate, the modelled wire time counting as idle.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include "src/Bench/Bench.h"
+#include <stdio.h>
+
+
+static TLx49012_Group group;
+
+
+int main(void)
+{
+	PSC3M5_MCU_Init();
+
+	if(false == TLx49012_GroupInit(&group))
+	{
+		printf("ERROR: simulated sensors not initialized\r\n");
+		return 1;
+	}
+
+	PSC3M5_Bench_Run(&group);
+
+	return 0;
+}
@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+# ----------------------------------------------------------------------------------------------------------------------
+# TLx49012 PSC3M5 deferred log decoder
+#
+# Expands the binary log messages of the examples built with PSC3M5_LOG_ENABLE=1 back to text. Message formats and
+# IDs are read from src/MCU/Log/Log.h, so the decoder always matches the firmware it is shipped with. printf() text
+# on the same serial port (initialization, profiling) is passed through.
+#
+# Usage:
+#   python log_decode.py --port COM5              Serial port, needs pyserial
+#   python log_decode.py capture.bin              Raw capture of the serial port
+#   ./host_program | python log_decode.py -       Linux host build, stream on stdin
+# ----------------------------------------------------------------------------------------------------------------------
+
+import argparse
+import os
+import re
+import sys
+
+LOG_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'src', 'MCU', 'Log', 'Log.h')
+
+LOG_SYNC = 0xFF         # PSC3M5_LOG_SYNC
+LOG_ARGS_MAX = 5        # PSC3M5_LOG_ARGS_MAX
+
+# printf() conversions used by the formats, plus %m: milli-units with 3 decimals
+CONVERSION = re.compile(r'%(0?\d*)l?([uxXm%])')
+
+
+def load_formats(path):
+    """Returns the message formats of Log.h, indexed by message ID."""
+    with open(path, encoding='utf-8') as header:
+        text = re.sub(r'//[^\n]*', '', header.read())
+
+    formats = dict(re.findall(r'#define\s+PSC3M5_LOG_FMT_(\w+)\s+"((?:[^"\\]|\\.)*)"', text))
+    ids = re.search(r'typedef\s+enum\s*\{(.*?)\}\s*PSC3M5_LogId\s*;', text, re.S).group(1)
+    names = [name for name in re.findall(r'PSC3M5_LOG_ID_(\w+)', ids) if name != 'COUNT']
+
+    return [formats[name] for name in names]
+
+
+def expand(fmt, args):
+    """Formats one message like printf() would on target."""
+    values = iter(args)
+
+    def convert(match):
+        width, kind = match.groups()
+        if kind == '%':
+            return '%'
+        value = next(values, 0)
+        if kind == 'm':
+            return '%u.%03u' % (value // 1000, value % 1000)
+        return ('%' + width + kind) % value
+
+    return CONVERSION.sub(convert, fmt)
+
+
+def read_varint(stream):
+    """Unsigned LEB128, None at the end of the stream."""
+    value = 0
+    for shift in range(0, 35, 7):
+        byte = stream.read(1)
+        if not byte:
+            return None
+        value |= (byte[0] & 0x7F) << shift
+        if byte[0] < 0x80:
+            return value
+    return value
+
+
+def decode(stream, formats, out):
+    text = bytearray()
+
+    while True:
+        byte = stream.read(1)
+        if not byte:
+            break
+
+        # Plain text, passed through line by line so that messages never split it
+        if byte[0] != LOG_SYNC:
+            text += byte
+            if byte == b'\n':
+                out.write(text.decode('utf-8', 'replace').replace('\r', ''))
+                out.flush()
+                text.clear()
+            continue
+
+        header = stream.read(2)
+        if len(header) < 2:
+            break
+        msg_id, count = header[0], header[1]
+        if msg_id >= len(formats) or count > LOG_ARGS_MAX:
+            out.write('<LOG: unknown message %u, resyncing>\n' % msg_id)
+            continue
+
+        args = [read_varint(stream) for _ in range(count)]
+        if None in args:
+            break
+
+        out.write(expand(formats[msg_id], args) + '\n')
+        out.flush()
+
+    if text:
+        out.write(text.decode('utf-8', 'replace'))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decodes the deferred log of the TLx49012 PSC3M5 examples.')
+    parser.add_argument('capture', nargs='?', help='Raw capture file, - for stdin')
+    parser.add_argument('--port', help='Serial port, e.g. COM5 or /dev/ttyACM0')
+    parser.add_argument('--baud', type=int, default=115200, help='Baud rate (default 115200)')
+    parser.add_argument('--header', default=LOG_HEADER, help='Log.h of the firmware')
+    options = parser.parse_args()
+
+    formats = load_formats(options.header)
+
+    if options.port:
+        import serial
+        stream = serial.Serial(options.port, options.baud)
+    elif options.capture and options.capture != '-':
+        stream = open(options.capture, 'rb')
+    else:
+        stream = sys.stdin.buffer
+
+    try:
+        decode(stream, formats, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
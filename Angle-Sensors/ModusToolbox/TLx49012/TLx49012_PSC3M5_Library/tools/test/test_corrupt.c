@@ -0,0 +1,180 @@
+// Responses corrupted on the wire (PSC3M5_SPI_SimCorruptFrames()) on one sensor at a time, the
+// shaft turning so that every good read brings a new angle:
+//  - TLx49012_GetAngleLSB() returns false for each of the N corrupted frames and leaves the
+//    angle alone, then reads again,
+//  - TLx49012_GroupReadAngles() keeps angle, time and velocity of that sensor for N reads,
+//    leaves it out of valid and counts it in errorCount, while the other sensors update,
+//  - crcErrors of that slave grows by N, the other slaves count none.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include <stdio.h>
+
+#define TEST_CORRUPT_FRAMES		(3U)
+#define TEST_READ_PERIOD_US		(500U)
+#define TEST_SPEED_LSB_PER_S	(1000000)
+#define TEST_UNSET				(0xEEEEU)
+
+
+static TLx49012_Group group;
+static uint32_t failures;
+
+
+static void fail(const char *what, uint8_t slave, uint8_t corrupted)
+{
+	failures++;
+	printf("FAIL: %s, slave %u, corrupted slave %u\n", what, slave, corrupted);
+}
+
+static uint32_t crc_errors_of(uint8_t slave)
+{
+	PSC3M5_SPI_FrameErrors errors;
+
+	PSC3M5_SPI_GetFrameErrors(slave, &errors);
+
+	return errors.crcErrors;
+}
+
+static void save_crc_errors(uint32_t *crcErrors)
+{
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		crcErrors[slave] = crc_errors_of(slave);
+	}
+}
+
+static void check_crc_errors(const uint32_t *crcErrors, uint8_t corrupted)
+{
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		uint32_t expected = crcErrors[slave] + ((slave == corrupted) ? TEST_CORRUPT_FRAMES : 0U);
+
+		if(crc_errors_of(slave) != expected)
+		{
+			fail("crcErrors not grown by the corrupted frames", slave, corrupted);
+		}
+	}
+}
+
+static void test_get_angle(uint8_t corrupted)
+{
+	uint32_t crcErrors[TLX49012_SENSOR_COUNT];
+	uint16_t angle;
+
+	save_crc_errors(crcErrors);
+	PSC3M5_SPI_SimCorruptFrames(corrupted, TEST_CORRUPT_FRAMES);
+
+	for(uint8_t read = 0; read < TEST_CORRUPT_FRAMES; read++)
+	{
+		PSC3M5_SPI_SimElapseUs(TEST_READ_PERIOD_US);
+
+		angle = TEST_UNSET;
+		if(TLx49012_GetAngleLSB(&angle, corrupted) || (angle != TEST_UNSET))
+		{
+			fail("corrupted angle read reported or stored", corrupted, corrupted);
+		}
+
+		for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			if((slave != corrupted) && (false == TLx49012_GetAngleLSB(&angle, slave)))
+			{
+				fail("angle read failing", slave, corrupted);
+			}
+		}
+	}
+
+	if(false == TLx49012_GetAngleLSB(&angle, corrupted))
+	{
+		fail("angle read failing after the corrupted frames", corrupted, corrupted);
+	}
+
+	check_crc_errors(crcErrors, corrupted);
+}
+
+static void test_group_read(uint8_t corrupted)
+{
+	uint32_t crcErrors[TLX49012_SENSOR_COUNT];
+	uint32_t errorCount = group.errorCount[corrupted];
+	uint16_t angle      = group.angle[corrupted];
+	uint32_t angleTime  = group.angleTime[corrupted];
+	int32_t velocity    = group.velocity[corrupted];
+
+	save_crc_errors(crcErrors);
+	PSC3M5_SPI_SimCorruptFrames(corrupted, TEST_CORRUPT_FRAMES);
+
+	for(uint8_t read = 0; read < TEST_CORRUPT_FRAMES; read++)
+	{
+		uint16_t previous[TLX49012_SENSOR_COUNT];
+
+		for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			previous[slave] = group.angle[slave];
+		}
+
+		PSC3M5_SPI_SimElapseUs(TEST_READ_PERIOD_US);
+		TLx49012_GroupReadAngles(&group);
+
+		if((group.angle[corrupted] != angle) || (group.angleTime[corrupted] != angleTime) || (group.velocity[corrupted] != velocity))
+		{
+			fail("corrupted read changed angle, time or velocity", corrupted, corrupted);
+		}
+		if(group.valid != (group.active & (uint8_t)~(1U << corrupted)))
+		{
+			fail("valid does not leave out the corrupted read only", corrupted, corrupted);
+		}
+
+		for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			if((slave != corrupted) && (group.angle[slave] == previous[slave]))
+			{
+				fail("angle not updated", slave, corrupted);
+			}
+		}
+	}
+
+	if(group.errorCount[corrupted] != (errorCount + TEST_CORRUPT_FRAMES))
+	{
+		fail("errorCount not grown by the corrupted frames", corrupted, corrupted);
+	}
+
+	PSC3M5_SPI_SimElapseUs(TEST_READ_PERIOD_US);
+	TLx49012_GroupReadAngles(&group);
+
+	if((group.valid != group.active) || (group.angle[corrupted] == angle))
+	{
+		fail("angle not read after the corrupted frames", corrupted, corrupted);
+	}
+
+	check_crc_errors(crcErrors, corrupted);
+}
+
+
+int main(void)
+{
+	PSC3M5_MCU_Init();
+
+	if(false == TLx49012_GroupInit(&group))
+	{
+		printf("FAIL: simulated sensors not initialized\n");
+		return 1;
+	}
+
+	PSC3M5_SPI_SimSetShaftSpeed(TEST_SPEED_LSB_PER_S);
+
+	// Velocity known from the second read on
+	for(uint8_t read = 0; read < 2; read++)
+	{
+		PSC3M5_SPI_SimElapseUs(TEST_READ_PERIOD_US);
+		TLx49012_GroupReadAngles(&group);
+	}
+
+	for(uint8_t corrupted = 0; corrupted < TLX49012_SENSOR_COUNT; corrupted++)
+	{
+		test_get_angle(corrupted);
+		test_group_read(corrupted);
+	}
+
+	printf("%s: %lu failures\n", failures ? "FAIL" : "PASS", (unsigned long)failures);
+
+	return failures ? 1 : 0;
+}
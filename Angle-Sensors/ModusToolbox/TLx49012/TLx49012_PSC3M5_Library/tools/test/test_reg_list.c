@@ -0,0 +1,199 @@
+// TLx49012_SPI_ReadRegList() against the next-frame protocol of the SPI simulation, on every
+// sensor of the group:
+//  - a list of K registers takes K+1 frames, data in request order, whatever the list shape,
+//  - the first N responses corrupted on the wire: the list fails when a response of the list
+//    is among them, exactly those registers keep their old data, the others are stored, and
+//    crcErrors of that slave grows by N while the other slaves count none.
+// The first response belongs to whatever was addressed before, so N = 1 still succeeds.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include "src/Sensor/Interface/SPI_Frontend.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_UNSET			(0xEEEEU)
+
+
+static TLx49012_Group group;
+static uint32_t failures;
+
+// Contiguous run, scattered, descending, two runs - within the register file of the simulation
+static const uint16_t list_run[]      = { 0x3F, 0x40, 0x41, 0x42, 0x43, 0x44 };
+static const uint16_t list_scatter[]  = { 0x45, 0x31, 0x7E, 0x3F, 0x52 };
+static const uint16_t list_reverse[]  = { 0x44, 0x43, 0x42, 0x41 };
+static const uint16_t list_two_runs[] = { 0x60, 0x61, 0x62, 0x30, 0x31, 0x32, 0x33, 0x7F };
+
+static const struct
+{
+	const uint16_t *addr;
+	uint8_t count;
+} lists[] =
+{
+	{ list_run,      sizeof(list_run) / sizeof(list_run[0]) },
+	{ list_scatter,  sizeof(list_scatter) / sizeof(list_scatter[0]) },
+	{ list_reverse,  sizeof(list_reverse) / sizeof(list_reverse[0]) },
+	{ list_two_runs, sizeof(list_two_runs) / sizeof(list_two_runs[0]) },
+};
+
+
+static void fail(const char *what, uint8_t slave, uint8_t list)
+{
+	failures++;
+	printf("FAIL: %s, slave %u list %u\n", what, slave, list);
+}
+
+static uint16_t register_value(uint8_t slave, uint16_t addr)
+{
+	return (uint16_t)(((addr * 40503U) ^ (0x1111U * (slave + 1U))) & 0xFFFFU);
+}
+
+static void fill_registers(void)
+{
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		for(uint16_t addr = 0x30; addr < 0x80; addr++)
+		{
+			PSC3M5_SPI_SimSetRegister(slave, (uint8_t)addr, register_value(slave, addr));
+		}
+	}
+}
+
+static uint32_t frames_of(uint8_t slave)
+{
+	PSC3M5_SPI_FrameErrors errors;
+
+	PSC3M5_SPI_GetFrameErrors(slave, &errors);
+
+	return errors.frames;
+}
+
+static uint32_t crc_errors_of(uint8_t slave)
+{
+	PSC3M5_SPI_FrameErrors errors;
+
+	PSC3M5_SPI_GetFrameErrors(slave, &errors);
+
+	return errors.crcErrors;
+}
+
+static void test_order(void)
+{
+	uint16_t data[TLX49012_REG_LIST_MAX];
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		for(uint8_t list = 0; list < (sizeof(lists) / sizeof(lists[0])); list++)
+		{
+			uint32_t frames = frames_of(slave);
+			uint8_t sent;
+
+			memset(data, 0xEE, sizeof(data));
+			sent = TLx49012_SPI_ReadRegList(lists[list].addr, lists[list].count, (list & 1U) != 0, data, slave);
+
+			if(sent != (lists[list].count + 1U))
+			{
+				fail("K registers not read in K+1 frames", slave, list);
+			}
+			if((frames_of(slave) - frames) != (lists[list].count + 1U))
+			{
+				fail("frames on the wire differ from K+1", slave, list);
+			}
+			for(uint8_t i = 0; i < lists[list].count; i++)
+			{
+				if(data[i] != register_value(slave, lists[list].addr[i]))
+				{
+					fail("data not in request order", slave, list);
+					break;
+				}
+			}
+		}
+	}
+
+	if(TLx49012_SPI_ReadRegList(list_run, 0, false, data, 0) != 0)
+	{
+		fail("empty list read", 0, 0);
+	}
+}
+
+static void test_corrupt(void)
+{
+	uint16_t data[TLX49012_REG_LIST_MAX];
+	const uint8_t count = sizeof(list_two_runs) / sizeof(list_two_runs[0]);
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		for(uint8_t corrupt = 1; corrupt <= (count + 1U); corrupt++)
+		{
+			uint32_t crcErrors[TLX49012_SENSOR_COUNT];
+			uint8_t sent;
+
+			for(uint8_t other = 0; other < TLX49012_SENSOR_COUNT; other++)
+			{
+				crcErrors[other] = crc_errors_of(other);
+			}
+
+			memset(data, 0xEE, sizeof(data));
+			PSC3M5_SPI_SimCorruptFrames(slave, corrupt);
+			sent = TLx49012_SPI_ReadRegList(list_two_runs, count, false, data, slave);
+
+			if((corrupt == 1U) ? (sent != (count + 1U)) : (sent != 0U))
+			{
+				fail("corrupted responses not reported", slave, corrupt);
+			}
+
+			// Responses 1..corrupt-1 hold registers 0..corrupt-2
+			for(uint8_t i = 0; i < count; i++)
+			{
+				uint16_t expected = ((i + 1U) < corrupt) ? TEST_UNSET : register_value(slave, list_two_runs[i]);
+
+				if(data[i] != expected)
+				{
+					fail("data of a corrupted response stored, or good data lost", slave, corrupt);
+					break;
+				}
+			}
+
+			for(uint8_t other = 0; other < TLX49012_SENSOR_COUNT; other++)
+			{
+				uint32_t expected = crcErrors[other] + ((other == slave) ? corrupt : 0U);
+
+				if(crc_errors_of(other) != expected)
+				{
+					fail("crcErrors not grown by the corrupted frames", other, corrupt);
+				}
+			}
+
+			// The other sensors read fine right after
+			for(uint8_t other = 0; other < TLX49012_SENSOR_COUNT; other++)
+			{
+				if(TLx49012_SPI_ReadRegList(list_run, sizeof(list_run) / sizeof(list_run[0]), false, data, other) == 0)
+				{
+					fail("list failing after the corrupted frames", other, corrupt);
+				}
+			}
+		}
+	}
+}
+
+
+int main(void)
+{
+	PSC3M5_MCU_Init();
+
+	if(false == TLx49012_GroupInit(&group))
+	{
+		printf("FAIL: simulated sensors not initialized\n");
+		return 1;
+	}
+
+	fill_registers();
+	PSC3M5_SPI_ClearFrameErrors();
+
+	test_order();
+	test_corrupt();
+
+	printf("%s: %lu failures\n", failures ? "FAIL" : "PASS", (unsigned long)failures);
+
+	return failures ? 1 : 0;
+}
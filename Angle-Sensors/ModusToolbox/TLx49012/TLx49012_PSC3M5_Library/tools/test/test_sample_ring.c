@@ -0,0 +1,166 @@
+// SampleRing under contention: a producer thread pushes numbered samples in bursts of 8 to
+// 47, more than the ring holds now and then, while a consumer thread drains them in bulk of
+// varying size. The bursts make the ring overflow on a single core as well. Each record carries its number in the timestamp and a payload derived
+// from it, so the consumer can detect torn, duplicated, reordered or lost records:
+//  - payload and flags match the timestamp,
+//  - numbers increase, and a jump comes with ANGLE_SAMPLE_GAP and only then,
+//  - received plus overflows equals pushed.
+
+#include "src/Acquisition/SampleRing.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#define TEST_SAMPLES		(5000000U)
+#define TEST_POP_MAX		(SAMPLE_RING_LENGTH + 7U)	// Bulk reads up to more than the ring holds
+
+
+static SampleRing ring;
+static volatile bool producer_done;
+
+static uint32_t pushed;
+static uint32_t received;
+static uint32_t gaps;
+static uint32_t failures;
+
+
+static void fill(AngleSample *sample, uint32_t number)
+{
+	sample->timestamp = number;
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		sample->syncRegister[slave].unsignedValue = (uint16_t)((number * (3U + slave)) ^ 0x5A5AU);
+	}
+	sample->flags = (uint16_t)(number & ~(uint32_t)ANGLE_SAMPLE_GAP);
+}
+
+static bool intact(const AngleSample *sample)
+{
+	AngleSample expected;
+
+	fill(&expected, sample->timestamp);
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		if(sample->syncRegister[slave].unsignedValue != expected.syncRegister[slave].unsignedValue)
+		{
+			return false;
+		}
+	}
+
+	return (sample->flags & (uint16_t)~ANGLE_SAMPLE_GAP) == expected.flags;
+}
+
+static void fail(const char *what, uint32_t number)
+{
+	if(failures++ < 10U)
+	{
+		printf("FAIL: %s at sample %lu\n", what, (unsigned long)number);
+	}
+}
+
+static void * producer(void *arg)
+{
+	AngleSample sample;
+	uint32_t burst = 0;
+	uint32_t bursts = 0;
+
+	(void)arg;
+
+	for(uint32_t number = 1; number <= TEST_SAMPLES; number++)
+	{
+		fill(&sample, number);
+		SampleRing_Push(&ring, &sample);
+		pushed++;
+
+		if(++burst >= (8U + ((bursts * 11U) % 40U)))
+		{
+			burst = 0;
+			bursts++;
+			sched_yield();
+		}
+	}
+
+	producer_done = true;
+
+	return NULL;
+}
+
+static void * consumer(void *arg)
+{
+	static AngleSample samples[TEST_POP_MAX];
+	uint32_t expected = 1;
+	uint32_t round    = 0;
+
+	(void)arg;
+
+	for(;;)
+	{
+		// Read before the pop - a pop after the last push then finds everything
+		bool done = producer_done;
+		uint32_t count = SampleRing_Pop(&ring, samples, 1U + (round * 7U) % TEST_POP_MAX);
+
+		for(uint32_t i = 0; i < count; i++)
+		{
+			uint32_t number = samples[i].timestamp;
+			bool gap = (samples[i].flags & ANGLE_SAMPLE_GAP) != 0;
+
+			if(!intact(&samples[i]))
+			{
+				fail("torn record", number);
+			}
+			if(number < expected)
+			{
+				fail("duplicate or reordered record", number);
+			}
+			if(gap != (number != expected))
+			{
+				fail(gap ? "gap flag without a drop" : "drop without a gap flag", number);
+			}
+			gaps += gap;
+			expected = number + 1U;
+		}
+		received += count;
+
+		if(done && (count == 0))
+		{
+			break;
+		}
+
+		// Ring empty - let the producer run
+		round++;
+		if(count == 0)
+		{
+			sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+
+int main(void)
+{
+	pthread_t threads[2];
+
+	SampleRing_Init(&ring);
+
+	pthread_create(&threads[0], NULL, &consumer, NULL);
+	pthread_create(&threads[1], NULL, &producer, NULL);
+	pthread_join(threads[1], NULL);
+	pthread_join(threads[0], NULL);
+
+	if((received + ring.overflows) != pushed)
+	{
+		fail("received plus overflows differs from pushed", received + ring.overflows);
+	}
+	if((ring.overflows != 0) && (gaps == 0))
+	{
+		fail("overflows without a gap", ring.overflows);
+	}
+
+	printf("SampleRing: %lu pushed, %lu received, %lu overflows, %lu gaps\n",
+		   (unsigned long)pushed, (unsigned long)received, (unsigned long)ring.overflows, (unsigned long)gaps);
+	printf("%s: %lu failures\n", failures ? "FAIL" : "PASS", (unsigned long)failures);
+
+	return failures ? 1 : 0;
+}
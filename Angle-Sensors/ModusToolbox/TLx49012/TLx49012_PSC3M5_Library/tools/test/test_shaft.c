@@ -0,0 +1,115 @@
+// TLx49012_GroupReadAngles() against the rotating-shaft model of the SPI simulation. The
+// sensors sit on one shaft at fixed mounting offsets; their predicted angles are read one
+// SPI frame after the other, so the raw angles of a group read differ by the turn during
+// those frames. Projected to the time of the first read, alignedAngle[] minus the offset
+// must agree across sensors within TEST_ALIGNED_LSB, at both speeds and in both directions.
+// The raw angles must differ by more, or the test would not exercise the projection.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include <stdio.h>
+
+#define TEST_READS			(500U)
+#define TEST_READ_PERIOD_US	(500U)
+#define TEST_ALIGNED_LSB	(1)
+#define TEST_RAW_MIN_LSB	(10)		// Least raw pair difference expected at 1000rpm
+
+// LSB per second of a 16-bit angle
+#define RPM_TO_LSB_PER_S(rpm)	((int32_t)(((int64_t)(rpm) * 65536) / 60))
+
+
+static TLx49012_Group group;
+static uint32_t failures;
+
+static const int32_t speeds_rpm[] = { 1000, 10000, -1000, -10000 };
+
+
+static uint16_t mounting_offset(uint8_t slave)
+{
+	return (uint16_t)(slave * 9000U);
+}
+
+static int32_t distance(uint16_t a, uint16_t b)
+{
+	int32_t d = (int16_t)(a - b);
+
+	return (d < 0) ? -d : d;
+}
+
+static void run(int32_t rpm)
+{
+	int32_t raw_max     = 0;
+	int32_t aligned_max = 0;
+
+	// Shaft at 0, each sensor at its offset, turning from now on
+	PSC3M5_SPI_SimSetShaftSpeed(0);
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		PSC3M5_SPI_SimSetRegister(slave, ANGLE_PRED_ADDR, mounting_offset(slave));
+	}
+	PSC3M5_SPI_SimSetShaftSpeed(RPM_TO_LSB_PER_S(rpm));
+	group.angleReads = 0;
+
+	for(uint32_t read = 0; read < TEST_READS; read++)
+	{
+		PSC3M5_SPI_SimElapseUs(TEST_READ_PERIOD_US);
+		TLx49012_GroupReadAngles(&group);
+
+		// Velocity known from the second read on
+		if(read == 0)
+		{
+			continue;
+		}
+
+		for(uint8_t slave = 1; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			int32_t raw     = distance(group.angle[slave] - mounting_offset(slave), group.angle[0]);
+			int32_t aligned = distance(group.alignedAngle[slave] - mounting_offset(slave), group.alignedAngle[0]);
+
+			raw_max     = (raw > raw_max) ? raw : raw_max;
+			aligned_max = (aligned > aligned_max) ? aligned : aligned_max;
+		}
+	}
+
+	printf("SHAFT,%u,%ld,%ld,%ld\n", TLX49012_SENSOR_COUNT, (long)rpm, (long)raw_max, (long)aligned_max);
+
+	if(aligned_max > TEST_ALIGNED_LSB)
+	{
+		failures++;
+		printf("FAIL: aligned angles differ by %ld LSB at %ld rpm\n", (long)aligned_max, (long)rpm);
+	}
+	if(raw_max < TEST_RAW_MIN_LSB)
+	{
+		failures++;
+		printf("FAIL: raw angles differ by %ld LSB only at %ld rpm\n", (long)raw_max, (long)rpm);
+	}
+}
+
+
+int main(void)
+{
+	PSC3M5_MCU_Init();
+
+	if(false == TLx49012_GroupInit(&group))
+	{
+		printf("FAIL: simulated sensors not initialized\n");
+		return 1;
+	}
+
+	printf("SHAFT,sensors,rpm,raw_max_lsb,aligned_max_lsb\n");
+
+	for(uint8_t i = 0; i < (sizeof(speeds_rpm) / sizeof(speeds_rpm[0])); i++)
+	{
+		run(speeds_rpm[i]);
+	}
+
+	if(group.valid != group.active)
+	{
+		failures++;
+		printf("FAIL: sensors missing from the last read\n");
+	}
+
+	printf("%s: %lu failures\n", failures ? "FAIL" : "PASS", (unsigned long)failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+// Adaptive trigger-to-read delay of TLx49012_GroupSync() against sensors with different sync
+// latencies (PSC3M5_SPI_SimSetSyncLatency()). The sync registers are read one frame after the
+// other, so the delay needed is the largest latency less the frames ahead of that sensor's read.
+// After TEST_SETTLE_CYCLES the delay must stay within TEST_DELAY_BELOW_US below and UP plus
+// TEST_DELAY_ABOVE_US above that need, and fresh cycles must outnumber the stale and partial
+// ones by TEST_FRESH_RATIO. The latencies first rise above the start delay, then fall again, so
+// the delay is followed in both directions.
+
+#include "src/MCU/MCU.h"
+#include "src/Sensor/SensorGroup.h"
+#include <stdio.h>
+
+#define TEST_SETTLE_CYCLES		(2000U)
+#define TEST_CYCLES				(4000U)
+#define TEST_CYCLE_PERIOD_US	(500U)
+#define TEST_FRAME_US			(32U)		// One sync read on the wire at SPI_BIT_RATE_HZ, slave switch rounded off
+#define TEST_DELAY_BELOW_US		(2)
+#define TEST_DELAY_ABOVE_US		(2)
+#define TEST_FRESH_RATIO		(50U)
+
+
+static TLx49012_Group group;
+static uint32_t failures;
+
+// Per slave, up to four sensors - the slowest one is not always read first
+static const uint16_t latencies_us[][4] =
+{
+	{ 150, 60, 170, 90 },
+	{ 40, 95, 20, 110 },
+};
+
+
+// Delay after which every sensor is read with its capture done
+static int32_t needed_delay(const uint16_t *latency)
+{
+	int32_t needed = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		int32_t delay = (int32_t)latency[slave] - (int32_t)(slave * TEST_FRAME_US);
+
+		needed = (delay > needed) ? delay : needed;
+	}
+
+	return needed;
+}
+
+static void sync_cycle(void)
+{
+	PSC3M5_SPI_SimElapseUs(TEST_CYCLE_PERIOD_US);
+	(void)TLx49012_GroupSync(&group, NULL);
+	while(group.readPending)
+	{
+		PSC3M5_SPI_Wait(&group.readPlan[group.readCount - 1]);
+	}
+}
+
+static void run(const uint16_t *latency)
+{
+	int32_t needed = needed_delay(latency);
+	int32_t delay_min = TLX49012_SYNC_DELAY_MAX_US;
+	int32_t delay_max = 0;
+	uint32_t fresh;
+	uint32_t late;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		PSC3M5_SPI_SimSetSyncLatency(slave, latency[slave]);
+	}
+
+	for(uint32_t cycle = 0; cycle < TEST_SETTLE_CYCLES; cycle++)
+	{
+		sync_cycle();
+	}
+
+	fresh = group.freshCycles;
+	late  = group.staleCycles + group.partialCycles;
+
+	for(uint32_t cycle = 0; cycle < TEST_CYCLES; cycle++)
+	{
+		sync_cycle();
+		delay_min = (group.readDelayUs < delay_min) ? group.readDelayUs : delay_min;
+		delay_max = (group.readDelayUs > delay_max) ? group.readDelayUs : delay_max;
+	}
+
+	fresh = group.freshCycles - fresh;
+	late  = (group.staleCycles + group.partialCycles) - late;
+
+	printf("SYNC,%u,%ld,%ld,%ld,%lu,%lu\n", TLX49012_SENSOR_COUNT, (long)needed, (long)delay_min, (long)delay_max,
+		   (unsigned long)fresh, (unsigned long)late);
+
+	if((delay_min < (needed - TEST_DELAY_BELOW_US)) || (delay_max > (needed + (int32_t)TLX49012_SYNC_DELAY_UP_US + TEST_DELAY_ABOVE_US)))
+	{
+		failures++;
+		printf("FAIL: delay %ld..%ldus, %ldus needed\n", (long)delay_min, (long)delay_max, (long)needed);
+	}
+	if(fresh < (TEST_FRESH_RATIO * late))
+	{
+		failures++;
+		printf("FAIL: %lu fresh cycles against %lu stale or partial\n", (unsigned long)fresh, (unsigned long)late);
+	}
+	if((group.errorCycles != 0) || (group.busyCount != 0))
+	{
+		failures++;
+		printf("FAIL: %lu error cycles, %lu busy\n", (unsigned long)group.errorCycles, (unsigned long)group.busyCount);
+	}
+}
+
+
+int main(void)
+{
+	PSC3M5_MCU_Init();
+
+	if(false == TLx49012_GroupInit(&group))
+	{
+		printf("FAIL: simulated sensors not initialized\n");
+		return 1;
+	}
+
+	printf("SYNC,sensors,needed_us,delay_min_us,delay_max_us,fresh_cycles,late_cycles\n");
+
+	for(uint8_t i = 0; i < (sizeof(latencies_us) / sizeof(latencies_us[0])); i++)
+	{
+		run(latencies_us[i]);
+	}
+
+	printf("%s: %lu failures\n", failures ? "FAIL" : "PASS", (unsigned long)failures);
+
+	return failures ? 1 : 0;
+}
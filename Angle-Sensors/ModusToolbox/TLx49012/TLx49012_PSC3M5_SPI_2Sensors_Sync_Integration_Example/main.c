@@ -62,18 +62,68 @@
 
 #include "src/MCU/MCU.h"
 #include "src/Sensor/TLx49012.h"
+#include "src/Sensor/SensorGroup.h"
+#include "src/Acquisition/SampleRing.h"
+#include "src/Bench/Bench.h"
 #include <stdio.h>
 
 
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define ACQUISITION_RATE_HZ		(20U)	// Readout rate, timer driven
+#define SAMPLE_DRAIN_MAX		(8U)	// Samples handled per loop pass
+#define STATS_PERIOD_TICKS		(ACQUISITION_RATE_HZ)	// Freshness statistics printed about once per second
+
+
 /*******************************************************************************
 * Global variables
 *******************************************************************************/
-uint16_t g_angleLsb_sensor0;		// Angle value received via SPI.
-uint16_t g_angleLsb_sensor1;		// Angle value received via SPI.
+uint16_t g_angleLsb[TLX49012_SENSOR_COUNT];	// Angle values received via SPI, indexed by slave select.
+
+SampleRing g_sampleRing;					// Acquisition -> main loop
+AngleSample g_samples[SAMPLE_DRAIN_MAX];	// Samples drained this pass
+
+TLx49012_Group g_sensors;					// All sensors on the SPI bus
+
+
+/*******************************************************************************
+* Function Name: SyncReadDone
+********************************************************************************
+* Summary:
+* Producer side of the sample ring. Runs in SPI completion context once the
+* sync registers of the whole group are in, stamps and flags the record and
+* queues it.
+*
+*******************************************************************************/
+static void SyncReadDone(const TLx49012_Group *group)
+{
+	AngleSample sample;
+
+	sample.timestamp = PSC3M5_Scheduler_Now();
+	sample.flags     = 0;
+
+	for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+	{
+		sample.syncRegister[slave] = group->syncRegister[slave];
+
+		if(!(group->active & (1U << slave)) || group->syncRegister[slave].bitfieldAccess.readStatus)
+		{
+			sample.flags |= ANGLE_SAMPLE_STALE(slave);
+		}
+		if((group->active & (uint8_t)~group->valid) & (1U << slave))
+		{
+			sample.flags |= ANGLE_SAMPLE_ERROR(slave);
+		}
+		if(group->syncRegister[slave].bitfieldAccess.triggerStatus)
+		{
+			sample.flags |= ANGLE_SAMPLE_TRIGGERED(slave);
+		}
+	}
+
+	SampleRing_Push(&g_sampleRing, &sample);
+}
 
-AngleSyncRegister g_angleSyncRegister_sensor0; // Register value
-AngleSyncRegister g_angleSyncRegister_sensor1; // Register value
-    
 
 /*******************************************************************************
 * Function Name: main
@@ -93,6 +143,8 @@ AngleSyncRegister g_angleSyncRegister_sensor1; // Register value
 int main(void)
 {
     cy_rslt_t result;
+    uint32_t count;
+    uint32_t ticks = 0;
 
     // Initialize the device and board peripherals
     result = cybsp_init();
@@ -106,44 +158,79 @@ int main(void)
 	// Fully initialize peripherals, with SPI interrupt and UART HAL
 	PSC3M5_MCU_Init();
 
-	// Initialize CRC LUT and soft-fuse the sensor
-	TLx49012_Init();
+	// Soft-fuse the sensors - all failing sensors are reported before stopping
+	if(false == TLx49012_GroupInit(&g_sensors))
+	{
+		CY_ASSERT(0);
+	}
 
     // Enable global interrupts
     __enable_irq();
     
+#if PSC3M5_BENCH_ENABLE
+	// SPI transport benchmark on the live sensors, CSV lines on the serial port
+	PSC3M5_Bench_Run(&g_sensors);
+#endif
+
+	// Empty sample ring before the first read can complete
+	SampleRing_Init(&g_sampleRing);
+
+	// Start periodic acquisition
+	PSC3M5_Scheduler_Init(ACQUISITION_RATE_HZ);
+    
     for (;;)
     {
+		// Wait for the next acquisition period - rate does not depend on loop time
+		ticks += PSC3M5_Scheduler_WaitTick();
+
 		/*	
-		// Send SPI read command and get LSB angle value
-		g_angleLsb_sensor0 = TLx49012_GetAngleLSB(SPI_SLAVE0);
-		Cy_SysLib_DelayUs(1);
-		g_angleLsb_sensor1 = TLx49012_GetAngleLSB(SPI_SLAVE1);
-		
-		// Print to serial port the angle in both LSB and degrees
-		PSC3M5_UART_SendAngleInfo(g_angleLsb_sensor0, SPI_SLAVE0);
-		PSC3M5_UART_SendAngleInfo(g_angleLsb_sensor1, SPI_SLAVE1);
+		// Without SYNC: predicted angles of all sensors, aligned to the time of the first read
+		TLx49012_GroupReadAngles(&g_sensors);
+
+		for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+		{
+			g_angleLsb[slave] = g_sensors.alignedAngle[slave];
+
+			// Print to serial port the angle in both LSB and degrees
+			PSC3M5_UART_SendAngleInfo(g_angleLsb[slave], slave);
+		}
 		*/
 		
-		// Send synchronization trigger
-		TLx49012_TriggerSyncPin();
-		
-		// Get sync register values
-		g_angleSyncRegister_sensor0 = TLx49012_GetAngleSyncRegister(SPI_SLAVE0);
-		Cy_SysLib_DelayUs(1);
-		g_angleSyncRegister_sensor1 = TLx49012_GetAngleSyncRegister(SPI_SLAVE1);
+		// One SYNC pulse and one batched read for all sensors, SyncReadDone() queues the result
+		TLx49012_GroupSync(&g_sensors, &SyncReadDone);
+
+		// Drain whatever the acquisition side has produced so far
+		count = SampleRing_Pop(&g_sampleRing, g_samples, SAMPLE_DRAIN_MAX);
 
-		// Check for new valid/fresh data
-		if((g_angleSyncRegister_sensor0.bitfieldAccess.readStatus == 0) && (g_angleSyncRegister_sensor1.bitfieldAccess.readStatus == 0))
+		for(uint32_t i = 0; i < count; i++)
 		{
-			// Fresh values - compute
-			printf(("*** NEW FRESH VALUES ***\r\n"));
-			PSC3M5_UART_SendSyncAngleInfo(g_angleSyncRegister_sensor0.bitfieldAccess.AngleSync,SPI_SLAVE0); 
-			PSC3M5_UART_SendSyncAngleInfo(g_angleSyncRegister_sensor1.bitfieldAccess.AngleSync,SPI_SLAVE1); 
+			// Check for new valid/fresh data
+			if((g_samples[i].flags & ANGLE_SAMPLE_STALE_ANY) == 0)
+			{
+				// Fresh values - compute
+				PSC3M5_LOG0(FRESH_VALUES);
+				for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+				{
+					PSC3M5_UART_SendSyncAngleInfo(g_samples[i].syncRegister[slave].bitfieldAccess.AngleSync, slave);
+				}
+			}
+		}
+
+		// Sync freshness - cycles with all, some or no sensors fresh, and the adapted read delay
+		if(ticks >= STATS_PERIOD_TICKS)
+		{
+			ticks = 0;
+			PSC3M5_LOG5(SYNC_STATS, g_sensors.freshCycles, g_sensors.partialCycles, g_sensors.staleCycles,
+						g_sensors.errorCycles, g_sensors.readDelayUs);
+			for(uint8_t slave = 0; slave < TLX49012_SENSOR_COUNT; slave++)
+			{
+				PSC3M5_LOG4(SENSOR_STATS, slave, g_sensors.freshCount[slave], g_sensors.staleCount[slave],
+							g_sensors.errorCount[slave]);
+			}
+
+			// Section timings - compiled out unless PSC3M5_PROFILE_ENABLE is set
+			PSC3M5_PROFILE_DUMP();
 		}
-		
-		// ~20Hz readout
-		Cy_SysLib_Delay(50);
     }
 }
 
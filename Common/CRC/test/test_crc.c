@@ -0,0 +1,153 @@
+// Host test of xensiv_crc.h: every table against a bitwise reference of its polynomial,
+// the table functions and XENSIV_CRC8_J1850_CONST3() against the same references, and
+// the catalog check values and former CRC4 table where they exist.
+
+// Tables of this program
+#define XENSIV_CRC_DEFINE_TABLES
+#include "xensiv_crc.h"
+#include <stdio.h>
+
+static unsigned failures;
+
+#define CHECK(cond, ...)														\
+	do { if(!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while(0)
+
+
+// MSB first CRC8 shift register, one byte
+static uint8_t ref_crc8_byte(uint8_t crc, uint8_t byte, uint8_t poly)
+{
+	crc ^= byte;
+	for(uint8_t bit = 0; bit < 8; bit++)
+	{
+		crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ poly) : (uint8_t)(crc << 1);
+	}
+
+	return crc;
+}
+
+static uint8_t ref_crc8(const uint8_t *buf, uint8_t len, uint8_t seed, uint8_t poly, uint8_t xorOut)
+{
+	uint8_t crc = seed;
+
+	while(len--)
+	{
+		crc = ref_crc8_byte(crc, *buf++, poly);
+	}
+
+	return (uint8_t)(crc ^ xorOut);
+}
+
+// SENT CRC4: remainder of seed, nibbles and one zero nibble over x^4 + x^3 + x^2 + 1, bit by bit
+static uint8_t ref_crc4_sent(const uint8_t *nibbles, uint8_t count, uint8_t seed)
+{
+	uint8_t crc = seed & 0x0F;
+
+	for(uint8_t i = 0; i <= count; i++)
+	{
+		uint8_t nibble = (i < count) ? (nibbles[i] & 0x0F) : 0;
+
+		for(int8_t bit = 3; bit >= 0; bit--)
+		{
+			crc = (uint8_t)((crc << 1) | ((nibble >> bit) & 1U));
+			if(crc & 0x10)
+			{
+				crc ^= 0x1D;
+			}
+		}
+	}
+
+	return crc;
+}
+
+// Deterministic test data
+static uint32_t lcg_state = 12345U;
+
+static uint8_t next_byte(void)
+{
+	lcg_state = (lcg_state * 1103515245U) + 12345U;
+	return (uint8_t)(lcg_state >> 16);
+}
+
+
+static void test_tables(void)
+{
+	static const uint8_t crc4_former[16] = { 0, 13, 7, 10, 14, 3, 9, 4, 1, 12, 6, 11, 15, 2, 8, 5 };
+
+	for(unsigned x = 0; x < 256; x++)
+	{
+		CHECK(XENSIV_CRC8_J1850_TABLE[x] == ref_crc8_byte(0, (uint8_t)x, 0x1D), "J1850 table[0x%02X]", x);
+		CHECK(XENSIV_CRC8_TLE493D_TABLE[x] == ref_crc8_byte(0, (uint8_t)x, 0x2F), "0x2F table[0x%02X]", x);
+	}
+
+	for(unsigned x = 0; x < 16; x++)
+	{
+		uint8_t nibble = (uint8_t)x;
+
+		// Table entry: x followed by one zero nibble
+		CHECK(XENSIV_CRC4_SENT_TABLE[x] == ref_crc4_sent(&nibble, 0, nibble), "CRC4 table[%u]", x);
+		CHECK(XENSIV_CRC4_SENT_TABLE[x] == crc4_former[x], "CRC4 table[%u] differs from the former table", x);
+	}
+}
+
+static void test_check_values(void)
+{
+	static const uint8_t check[9] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+	// CRC-8/SAE-J1850 catalog check value
+	CHECK(xensiv_crc8_j1850(check, 9, 0xFF) == 0x4B, "J1850 check value");
+	CHECK(ref_crc8(check, 9, 0xFF, 0x1D, 0xFF) == 0x4B, "J1850 reference check value");
+}
+
+static void test_functions(void)
+{
+	uint8_t buf[32];
+
+	for(unsigned run = 0; run < 10000; run++)
+	{
+		uint8_t len = (uint8_t)(run % sizeof(buf));
+
+		for(uint8_t i = 0; i < len; i++)
+		{
+			buf[i] = next_byte();
+		}
+
+		CHECK(xensiv_crc8_j1850(buf, len, XENSIV_CRC8_J1850_SEED_SPI) == ref_crc8(buf, len, 0xFF, 0x1D, 0xFF), "J1850 SPI seed, run %u", run);
+		CHECK(xensiv_crc8_j1850(buf, len, XENSIV_CRC8_J1850_SEED_CONFIG) == ref_crc8(buf, len, 0xAA, 0x1D, 0xFF), "J1850 config seed, run %u", run);
+		CHECK(xensiv_crc8_tle493d(buf, len) == ref_crc8(buf, len, XENSIV_CRC8_TLE493D_SEED, 0x2F, 0x00), "0x2F, run %u", run);
+
+		for(uint8_t i = 0; i < len; i++)
+		{
+			buf[i] &= 0x0F;
+		}
+		CHECK(xensiv_crc4_sent(buf, len, XENSIV_CRC4_SENT_SEED) == ref_crc4_sent(buf, len, XENSIV_CRC4_SENT_SEED), "CRC4, run %u", run);
+	}
+}
+
+static void test_const3(void)
+{
+	// Folded by the compiler - usable as an initializer
+	static const uint8_t frame[4] = { 0x12, 0x34, 0x56, XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, 0x12, 0x34, 0x56) };
+
+	CHECK(frame[3] == ref_crc8(frame, 3, 0xFF, 0x1D, 0xFF), "CONST3 initializer");
+
+	for(unsigned run = 0; run < 10000; run++)
+	{
+		uint8_t b[3] = { next_byte(), next_byte(), next_byte() };
+
+		CHECK(XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, b[0], b[1], b[2]) == ref_crc8(b, 3, 0xFF, 0x1D, 0xFF), "CONST3 SPI seed, run %u", run);
+		CHECK(XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_CONFIG, b[0], b[1], b[2]) == ref_crc8(b, 3, 0xAA, 0x1D, 0xFF), "CONST3 config seed, run %u", run);
+	}
+}
+
+
+int main(void)
+{
+	test_tables();
+	test_check_values();
+	test_functions();
+	test_const3();
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+
+	return failures ? 1 : 0;
+}
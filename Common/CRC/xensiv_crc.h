@@ -0,0 +1,144 @@
+/**
+ * @file        xensiv_crc.h
+ * @brief       Header-only CRC library shared by the XENSIV magnetic sensor examples.
+ *
+ * All lookup tables are generated by the preprocessor and placed in flash as const data:
+ * no CRC init function, no RAM table, nothing to run at boot.
+ *
+ * Supported checksums:
+ *  - CRC8 SAE J1850, polynomial 0x1D, inverted result (TLx49012 SPI frames seed 0xFF,
+ *    TLx49012 user configuration/bitmap blocks seed 0xAA);
+ *  - CRC8 polynomial 0x2F, seed 0x00, no final XOR (TLE493D-P3I8 CRC at read);
+ *  - CRC4 SAE J2716 SENT, polynomial 0x1D (x^4 + x^3 + x^2 + 1), seed 5 (TLx49012, TLE4998).
+ *
+ * Every CRC used here is linear in its input, so each table entry is the XOR of the
+ * entries of its set bits. The XENSIV_CRCx_LUT_*() macros use this to evaluate a table
+ * entry as a constant expression; they can also be used directly to compute CRCs of
+ * constant data at compile time (see XENSIV_CRC8_J1850_CONST3()).
+ *
+ * The tables are defined once per program: exactly one source file defines
+ * XENSIV_CRC_DEFINE_TABLES before including this header, all others only see the
+ * extern declarations.
+ */
+
+#ifndef COMMON_CRC_XENSIV_CRC_H_
+#define COMMON_CRC_XENSIV_CRC_H_
+
+
+#include <stdint.h>
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Seeds
+#define XENSIV_CRC8_J1850_SEED_SPI		0xFF	// TLx49012 SPI command/response frames
+#define XENSIV_CRC8_J1850_SEED_CONFIG	0xAA	// TLx49012 configuration/bitmap blocks
+#define XENSIV_CRC8_TLE493D_SEED		0x00	// TLE493D CRC at read
+#define XENSIV_CRC4_SENT_SEED			0x05	// SENT status and data nibbles
+
+// CRC8 SAE J1850 (poly 0x1D) table entry
+#define XENSIV_CRC8_LUT_J1850(x)											\
+	( (((x) & 0x01) ? 0x1D : 0) ^ (((x) & 0x02) ? 0x3A : 0) ^				\
+	  (((x) & 0x04) ? 0x74 : 0) ^ (((x) & 0x08) ? 0xE8 : 0) ^				\
+	  (((x) & 0x10) ? 0xCD : 0) ^ (((x) & 0x20) ? 0x87 : 0) ^				\
+	  (((x) & 0x40) ? 0x13 : 0) ^ (((x) & 0x80) ? 0x26 : 0) )
+
+// CRC8 TLE493D (poly 0x2F) table entry
+#define XENSIV_CRC8_LUT_TLE493D(x)											\
+	( (((x) & 0x01) ? 0x2F : 0) ^ (((x) & 0x02) ? 0x5E : 0) ^				\
+	  (((x) & 0x04) ? 0xBC : 0) ^ (((x) & 0x08) ? 0x57 : 0) ^				\
+	  (((x) & 0x10) ? 0xAE : 0) ^ (((x) & 0x20) ? 0x73 : 0) ^				\
+	  (((x) & 0x40) ? 0xE6 : 0) ^ (((x) & 0x80) ? 0xE3 : 0) )
+
+// CRC4 SENT (poly 0x1D) table entry
+#define XENSIV_CRC4_LUT_SENT(x)												\
+	( (((x) & 0x01) ? 0x0D : 0) ^ (((x) & 0x02) ? 0x07 : 0) ^				\
+	  (((x) & 0x04) ? 0x0E : 0) ^ (((x) & 0x08) ? 0x01 : 0) )
+
+// Compile-time CRC8 SAE J1850 over three constant bytes, e.g. the CRC byte of a TLx49012 SPI frame
+#define XENSIV_CRC8_J1850_STEP(crc, byte)	XENSIV_CRC8_LUT_J1850(((crc) ^ (byte)) & 0xFF)
+#define XENSIV_CRC8_J1850_CONST3(seed, b0, b1, b2)							\
+	((uint8_t)(~XENSIV_CRC8_J1850_STEP(XENSIV_CRC8_J1850_STEP(XENSIV_CRC8_J1850_STEP((seed), (b0)), (b1)), (b2)) & 0xFF))
+
+// Table generators
+#define XENSIV_CRC_TABLE_4(LUT, a)		LUT(a), LUT((a) + 1), LUT((a) + 2), LUT((a) + 3)
+#define XENSIV_CRC_TABLE_16(LUT, a)		XENSIV_CRC_TABLE_4(LUT, a), XENSIV_CRC_TABLE_4(LUT, (a) + 4),			\
+										XENSIV_CRC_TABLE_4(LUT, (a) + 8), XENSIV_CRC_TABLE_4(LUT, (a) + 12)
+#define XENSIV_CRC_TABLE_64(LUT, a)		XENSIV_CRC_TABLE_16(LUT, a), XENSIV_CRC_TABLE_16(LUT, (a) + 16),		\
+										XENSIV_CRC_TABLE_16(LUT, (a) + 32), XENSIV_CRC_TABLE_16(LUT, (a) + 48)
+#define XENSIV_CRC_TABLE_256(LUT)		XENSIV_CRC_TABLE_64(LUT, 0), XENSIV_CRC_TABLE_64(LUT, 64),				\
+										XENSIV_CRC_TABLE_64(LUT, 128), XENSIV_CRC_TABLE_64(LUT, 192)
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Global variables--------------------------------------------------*/
+/*********************************************************************************************************************/
+
+extern const uint8_t XENSIV_CRC8_J1850_TABLE[256];
+extern const uint8_t XENSIV_CRC8_TLE493D_TABLE[256];
+extern const uint8_t XENSIV_CRC4_SENT_TABLE[16];
+
+// Single definition, in the source file that defines XENSIV_CRC_DEFINE_TABLES
+#ifdef XENSIV_CRC_DEFINE_TABLES
+const uint8_t XENSIV_CRC8_J1850_TABLE[256]	= { XENSIV_CRC_TABLE_256(XENSIV_CRC8_LUT_J1850) };
+const uint8_t XENSIV_CRC8_TLE493D_TABLE[256]	= { XENSIV_CRC_TABLE_256(XENSIV_CRC8_LUT_TLE493D) };
+const uint8_t XENSIV_CRC4_SENT_TABLE[16]		= { XENSIV_CRC_TABLE_16(XENSIV_CRC4_LUT_SENT, 0) };
+#endif
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*******************************************************************************
+ * Function Name: xensiv_crc8_j1850
+ ***************************************************************************//**
+ * \brief  CRC8 SAE J1850 (poly 0x1D), inverted result.
+ * \param  buf   Data to be processed.
+ * \param  len   Number of bytes.
+ * \param  seed  XENSIV_CRC8_J1850_SEED_SPI or XENSIV_CRC8_J1850_SEED_CONFIG.
+ ******************************************************************************/
+static inline uint8_t xensiv_crc8_j1850(const uint8_t *buf, uint8_t len, uint8_t seed)
+{
+	uint8_t crc = seed;
+
+	while(len--) crc = XENSIV_CRC8_J1850_TABLE[crc ^ *buf++];
+
+	return (uint8_t)~crc;
+}
+
+/*******************************************************************************
+ * Function Name: xensiv_crc8_tle493d
+ ***************************************************************************//**
+ * \brief  CRC8 poly 0x2F, seed 0x00, no final XOR.
+ * \param  buf   Data to be processed.
+ * \param  len   Number of bytes.
+ ******************************************************************************/
+static inline uint8_t xensiv_crc8_tle493d(const uint8_t *buf, uint8_t len)
+{
+	uint8_t crc = XENSIV_CRC8_TLE493D_SEED;
+
+	while(len--) crc = XENSIV_CRC8_TLE493D_TABLE[crc ^ *buf++];
+
+	return crc;
+}
+
+/*******************************************************************************
+ * Function Name: xensiv_crc4_sent
+ ***************************************************************************//**
+ * \brief  SAE J2716 SENT CRC4 over 4-bit nibbles, including the final
+ *         zero-nibble augmentation.
+ * \param  nibbles  One nibble per byte, lower 4 bits used.
+ * \param  count    Number of nibbles.
+ * \param  seed     XENSIV_CRC4_SENT_SEED for SENT frames.
+ ******************************************************************************/
+static inline uint8_t xensiv_crc4_sent(const uint8_t *nibbles, uint8_t count, uint8_t seed)
+{
+	uint8_t crc = seed & 0x0F;
+
+	while(count--) crc = (uint8_t)((*nibbles++ & 0x0F) ^ XENSIV_CRC4_SENT_TABLE[crc]);
+
+	return XENSIV_CRC4_SENT_TABLE[crc];
+}
+
+
+#endif /* COMMON_CRC_XENSIV_CRC_H_ */
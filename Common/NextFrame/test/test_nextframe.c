@@ -0,0 +1,276 @@
+// Host test of xensiv_nextframe.h: the frames planned for register lists (K+1 frames, AC_READ_INC runs
+// for contiguous addresses, status cleared by the last frame only) and the executor against a simulated
+// next-frame sensor (data in request order, responses failing the check fail the list).
+
+// Tables of this program
+#define XENSIV_CRC_DEFINE_TABLES
+#include "xensiv_nextframe.h"
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_LIST			64
+
+// Status bit the simulated sensor raises on request, reported as an error by the executor
+#define SIM_STATUS_ERROR	0x40
+
+static unsigned failures;
+
+#define CHECK(cond, ...)														\
+	do { if(!(cond)) { failures++; printf("FAIL: " __VA_ARGS__); printf("\n"); } } while(0)
+
+
+// Simulated sensor: the response of every frame carries the register addressed so far, CMD_ADDR
+// moves the pointer, a read frame advances it by one
+static uint16_t sim_pointer;
+static uint8_t sim_status;
+static uint32_t sim_frames;
+static uint32_t sim_clears;				// Read frames clearing the status
+static uint32_t sim_last_clear;			// Frame number of the last one
+static uint32_t sim_corrupt_frame;		// Frame number whose response gets a flipped data bit, 0 if none
+static uint32_t sim_error_frame;		// Frame number whose response reports SIM_STATUS_ERROR, 0 if none
+
+static uint16_t sim_register(uint16_t addr)
+{
+	return (uint16_t)((addr * 40503U) ^ 0x5A5AU);
+}
+
+static void sim_reset(void)
+{
+	sim_pointer       = 0x1234;
+	sim_status        = 0;
+	sim_frames        = 0;
+	sim_clears        = 0;
+	sim_last_clear    = 0;
+	sim_corrupt_frame = 0;
+	sim_error_frame   = 0;
+}
+
+static xensiv_rsp_frame_t sim_transfer(const uint8_t frame[4], void *context)
+{
+	uint8_t rx[4];
+	uint16_t data = sim_register(sim_pointer);
+	uint32_t response;
+
+	(void)context;
+	sim_frames++;
+
+	CHECK(xensiv_crc8_j1850(frame, 3, XENSIV_CRC8_J1850_SEED_SPI) == frame[3], "frame %u: bad command CRC", sim_frames);
+
+	rx[0] = (sim_frames == sim_error_frame) ? SIM_STATUS_ERROR : sim_status;
+	rx[1] = (uint8_t)(data >> 8);
+	rx[2] = (uint8_t)data;
+	rx[3] = xensiv_crc8_j1850(rx, 3, XENSIV_CRC8_J1850_SEED_SPI);
+
+	// Bit error on the wire, after the CRC
+	if(sim_frames == sim_corrupt_frame)
+	{
+		rx[2] ^= 0x10;
+	}
+
+	if(frame[0] == XENSIV_NXF_CMD_ADDR)
+	{
+		CHECK((frame[2] & 0x03) == XENSIV_NXF_AC_READ_INC, "frame %u: access type %u", sim_frames, frame[2] & 0x03);
+		sim_pointer = (uint16_t)((((uint16_t)frame[1] << 6) | (frame[2] >> 2)) & XENSIV_NXF_ADDR_MASK);
+	}
+	else
+	{
+		CHECK(frame[0] == XENSIV_NXF_CMD_DATA_ADDR, "frame %u: command 0x%02X", sim_frames, frame[0]);
+		if(frame[2] == 0xFF)
+		{
+			sim_clears++;
+			sim_last_clear = sim_frames;
+		}
+		sim_pointer = (uint16_t)((sim_pointer + 1U) & XENSIV_NXF_ADDR_MASK);
+	}
+
+	response = ((uint32_t)rx[0] << 24) | ((uint32_t)rx[1] << 16) | ((uint32_t)rx[2] << 8) | rx[3];
+
+	return xensiv_rsp_decode(response, SIM_STATUS_ERROR);
+}
+
+// Deterministic test data
+static uint32_t lcg_state = 12345U;
+
+static uint16_t next_random(void)
+{
+	lcg_state = (lcg_state * 1103515245U) + 12345U;
+	return (uint16_t)(lcg_state >> 16);
+}
+
+// Random list of runs of contiguous addresses, wrapping at the end of the 14-bit space included
+static uint16_t random_list(uint16_t *addrList)
+{
+	uint16_t count = (uint16_t)(1U + (next_random() % MAX_LIST));
+	uint16_t i = 0;
+
+	while(i < count)
+	{
+		uint16_t addr = (next_random() & 7U) ? (uint16_t)(next_random() & XENSIV_NXF_ADDR_MASK) : (uint16_t)(0x3FFCU + (next_random() & 3U));
+		uint16_t run = (uint16_t)(1U + (next_random() % 6U));
+
+		for(uint16_t j = 0; (j < run) && (i < count); j++, i++)
+		{
+			addrList[i] = (uint16_t)((addr + j) & XENSIV_NXF_ADDR_MASK);
+		}
+	}
+
+	return count;
+}
+
+// Frame i is a CMD_ADDR frame unless it continues a run or is the final read
+static bool expect_command(const uint16_t *addrList, uint16_t count, uint16_t i)
+{
+	return (i == 0) || ((i < count) && (addrList[i] != ((addrList[i - 1] + 1U) & XENSIV_NXF_ADDR_MASK)));
+}
+
+
+static void check_plan(const uint16_t *addrList, uint16_t count, bool clearStatus)
+{
+	uint8_t frames[MAX_LIST + 1][4];
+	uint16_t built = xensiv_nxf_plan_read_list(addrList, count, clearStatus, frames);
+
+	CHECK(built == count + 1U, "%u registers planned in %u frames", count, built);
+
+	for(uint16_t i = 0; i < built; i++)
+	{
+		uint8_t expected[4];
+
+		if(expect_command(addrList, count, i))
+		{
+			xensiv_nxf_command_frame(expected, addrList[i], XENSIV_NXF_AC_READ_INC);
+		}
+		else
+		{
+			memcpy(expected, XENSIV_NXF_READ_FRAME[(clearStatus && (i == count)) ? 1 : 0], 4);
+		}
+
+		CHECK(memcmp(frames[i], expected, 4) == 0, "list of %u, frame %u differs", count, i);
+	}
+}
+
+// The table of the README
+static void test_plan_examples(void)
+{
+	static const uint16_t single[]     = { 0x3F };
+	static const uint16_t contiguous[] = { 0x3F, 0x40, 0x41 };
+	static const uint16_t scattered[]  = { 0x0C, 0x45, 0x02 };
+	static const uint16_t wrapping[]   = { 0x3FFF, 0x0000 };
+	uint8_t frames[4][4];
+
+	CHECK(xensiv_nxf_plan_read_list(single, 0, false, frames) == 0, "empty list planned");
+
+	CHECK(xensiv_nxf_plan_read_list(single, 1, false, frames) == 2, "single register not 2 frames");
+	CHECK((frames[0][0] == XENSIV_NXF_CMD_ADDR) && (frames[1][0] == XENSIV_NXF_CMD_DATA_ADDR), "single register frames");
+
+	CHECK(xensiv_nxf_plan_read_list(contiguous, 3, false, frames) == 4, "contiguous run not 4 frames");
+	CHECK((frames[0][0] == XENSIV_NXF_CMD_ADDR) && (frames[1][0] == XENSIV_NXF_CMD_DATA_ADDR) &&
+		  (frames[2][0] == XENSIV_NXF_CMD_DATA_ADDR) && (frames[3][0] == XENSIV_NXF_CMD_DATA_ADDR), "contiguous run not one AC_READ_INC run");
+
+	CHECK(xensiv_nxf_plan_read_list(scattered, 3, false, frames) == 4, "scattered list not 4 frames");
+	CHECK((frames[0][0] == XENSIV_NXF_CMD_ADDR) && (frames[1][0] == XENSIV_NXF_CMD_ADDR) &&
+		  (frames[2][0] == XENSIV_NXF_CMD_ADDR) && (frames[3][0] == XENSIV_NXF_CMD_DATA_ADDR), "scattered list frames");
+
+	CHECK(xensiv_nxf_plan_read_list(wrapping, 2, false, frames) == 3, "wrapping run not 3 frames");
+	CHECK(frames[1][0] == XENSIV_NXF_CMD_DATA_ADDR, "0x3FFF, 0x0000 not contiguous");
+}
+
+static void test_plans(void)
+{
+	uint16_t addrList[MAX_LIST];
+
+	for(uint32_t n = 0; n < 2000; n++)
+	{
+		uint16_t count = random_list(addrList);
+
+		check_plan(addrList, count, (n & 1U) != 0);
+	}
+}
+
+// Executor against the simulated sensor, frames compared with the plan
+static void test_read_lists(void)
+{
+	uint16_t addrList[MAX_LIST];
+	uint16_t data[MAX_LIST];
+
+	for(uint32_t n = 0; n < 2000; n++)
+	{
+		uint16_t count = random_list(addrList);
+		bool clearStatus = (n & 1U) != 0;
+		uint16_t sent;
+
+		sim_reset();
+		sent = xensiv_nxf_read_list(addrList, count, clearStatus, data, &sim_transfer, NULL);
+
+		CHECK(sent == count + 1U, "list %u: %u registers returned %u", n, count, sent);
+		CHECK(sim_frames == count + 1U, "list %u: %u registers took %u frames", n, count, sim_frames);
+		CHECK(sim_clears == (clearStatus ? 1U : 0U), "list %u: %u frames cleared the status", n, sim_clears);
+		CHECK(!clearStatus || (sim_last_clear == sim_frames), "list %u: status cleared before the last frame", n);
+
+		for(uint16_t i = 0; i < count; i++)
+		{
+			CHECK(data[i] == sim_register(addrList[i]), "list %u: register %u (0x%04X) out of order", n, i, addrList[i]);
+		}
+	}
+
+	sim_reset();
+	CHECK(xensiv_nxf_read_list(addrList, 0, true, data, &sim_transfer, NULL) == 0, "empty list read");
+	CHECK(sim_frames == 0, "empty list sent %u frames", sim_frames);
+}
+
+// A response failing the check fails the list and leaves its register unchanged, the others are stored
+static void test_failures(void)
+{
+	static const uint16_t addrList[] = { 0x3F, 0x40, 0x41, 0x0C, 0x45, 0x46 };
+	const uint16_t count = sizeof(addrList) / sizeof(addrList[0]);
+	uint16_t data[sizeof(addrList) / sizeof(addrList[0])];
+
+	for(uint16_t bad = 1; bad <= count; bad++)
+	{
+		for(uint8_t kind = 0; kind < 2; kind++)
+		{
+			memset(data, 0xEE, sizeof(data));
+			sim_reset();
+
+			// Frame numbers count from 1, the response of frame bad + 1 holds register bad - 1
+			if(kind == 0)
+			{
+				sim_corrupt_frame = bad + 1U;
+			}
+			else
+			{
+				sim_error_frame = bad + 1U;
+			}
+
+			CHECK(xensiv_nxf_read_list(addrList, count, false, data, &sim_transfer, NULL) == 0,
+				  "%s of register %u passed", kind ? "status error" : "CRC error", bad - 1U);
+			CHECK(sim_frames == count + 1U, "list not completed after a failure");
+
+			for(uint16_t i = 0; i < count; i++)
+			{
+				uint16_t expected = (i == (bad - 1U)) ? 0xEEEE : sim_register(addrList[i]);
+
+				CHECK(data[i] == expected, "%s of register %u: register %u is 0x%04X", kind ? "status error" : "CRC error",
+					  bad - 1U, i, data[i]);
+			}
+		}
+	}
+
+	// The first response belongs to whatever was addressed before - not part of the list
+	sim_reset();
+	sim_corrupt_frame = 1;
+	CHECK(xensiv_nxf_read_list(addrList, count, false, data, &sim_transfer, NULL) == count + 1U,
+		  "corrupted response before the list failed the list");
+}
+
+
+int main(void)
+{
+	test_plan_examples();
+	test_plans();
+	test_read_lists();
+	test_failures();
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,236 @@
+/**
+ * @file        xensiv_nextframe.h
+ * @brief       Header-only TLx49012 SPI next-frame command builder and register list executor.
+ *
+ * In the next-frame protocol a CMD_ADDR frame only sets the register pointer; the register data is
+ * shifted out on MISO during the following frame, whatever that frame is. A read of K registers done
+ * as K separate "command + read" pairs therefore costs 2K frames.
+ *
+ * The register list executor overlaps the command of register N+1 with the response of register N:
+ *  - the first frame addresses the first register (its response is discarded);
+ *  - every following register is addressed with a new CMD_ADDR frame, unless it directly follows the
+ *    previous one, in which case a plain read frame is sent and AC_READ_INC advances the pointer;
+ *  - a final read frame shifts out the last register.
+ * Reading K registers costs K + 1 frames, whatever the address order. Only the last frame clears the
+ * device status, if requested. Every response is checked (CRC and status, xensiv_response.h): a register
+ * whose response fails keeps its old data and fails the list.
+ */
+
+#ifndef COMMON_NEXTFRAME_XENSIV_NEXTFRAME_H_
+#define COMMON_NEXTFRAME_XENSIV_NEXTFRAME_H_
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xensiv_crc.h"
+#include "xensiv_response.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Next frame commands
+#define XENSIV_NXF_CMD_ADDR			0xFF
+#define XENSIV_NXF_CMD_END			0xFE
+#define XENSIV_NXF_CMD_DATA_ADDR	0xFD
+
+// Register access type of CMD_ADDR
+#define XENSIV_NXF_AC_READ_INC		0
+#define XENSIV_NXF_AC_WRITE_CONT	1
+#define XENSIV_NXF_AC_WRITE_INC		2
+
+// 14-bit register address space
+#define XENSIV_NXF_ADDR_MASK		0x3FFF
+
+// Frames needed to read a list of count registers
+#define XENSIV_NXF_READ_LIST_FRAMES(count)	((count) + 1U)
+
+// Register data of a 32-bit MISO frame: status, data MSB, data LSB, CRC
+#define XENSIV_NXF_RESPONSE_DATA(response)	((uint16_t)(((response) >> 8) & 0xFFFF))
+
+// Frames needed to write count consecutive registers with AC_WRITE_INC
+#define XENSIV_NXF_WRITE_BURST_FRAMES(count)	((count) + 1U)
+
+// Constant CMD_ADDR frame initializer, CRC computed at compile time
+#define XENSIV_NXF_COMMAND_FRAME(addr, accessType)												\
+	{																							\
+		XENSIV_NXF_CMD_ADDR,																	\
+		(uint8_t)(((addr) >> 6) & 0xFF),														\
+		(uint8_t)((((addr) & 0x3F) << 2) | ((accessType) & 0x03)),								\
+		XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, XENSIV_NXF_CMD_ADDR,				\
+								 (((addr) >> 6) & 0xFF), ((((addr) & 0x3F) << 2) | ((accessType) & 0x03)))	\
+	}
+
+// Constant CMD_DATA_ADDR write frame initializer, CRC computed at compile time
+#define XENSIV_NXF_WRITE_FRAME(data)															\
+	{																							\
+		XENSIV_NXF_CMD_DATA_ADDR,																\
+		(uint8_t)(((data) >> 8) & 0xFF),														\
+		(uint8_t)((data) & 0xFF),																\
+		XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, XENSIV_NXF_CMD_DATA_ADDR,			\
+								 (((data) >> 8) & 0xFF), ((data) & 0xFF))						\
+	}
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Sends one 4-byte frame and returns the MISO frame, decoded and checked with xensiv_rsp_decode()
+typedef xensiv_rsp_frame_t (*xensiv_nxf_transfer_t)(const uint8_t frame[4], void *context);
+
+/*********************************************************************************************************************/
+/*--------------------------------------------Private Variables/Constants--------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Read data frames, indexed by clearStatus. Constant, CRC computed at compile time.
+static const uint8_t XENSIV_NXF_READ_FRAME[2][4] =
+{
+	{ XENSIV_NXF_CMD_DATA_ADDR, 0x00, 0x00, XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, XENSIV_NXF_CMD_DATA_ADDR, 0x00, 0x00) },
+	{ XENSIV_NXF_CMD_DATA_ADDR, 0x00, 0xFF, XENSIV_CRC8_J1850_CONST3(XENSIV_CRC8_J1850_SEED_SPI, XENSIV_NXF_CMD_DATA_ADDR, 0x00, 0xFF) }
+};
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*******************************************************************************
+ * Function Name: xensiv_nxf_command_frame
+ ***************************************************************************//**
+ * \brief  Builds a CMD_ADDR frame.
+ * \param  frame       4-byte destination, CRC included.
+ * \param  addr        Register address, 14-bit.
+ * \param  accessType  XENSIV_NXF_AC_* access type.
+ ******************************************************************************/
+static inline void xensiv_nxf_command_frame(uint8_t frame[4], uint16_t addr, uint8_t accessType)
+{
+	frame[0] = XENSIV_NXF_CMD_ADDR;
+	frame[1] = (uint8_t)((addr >> 6) & 0xFF);						// 14 bit address - take MSB
+	frame[2] = (uint8_t)(((addr & 0x3F) << 2) | (accessType & 0x03));	// 6 bit LSB from address and access type
+	frame[3] = xensiv_crc8_j1850(frame, 3, XENSIV_CRC8_J1850_SEED_SPI);
+}
+
+/*******************************************************************************
+ * Function Name: xensiv_nxf_write_frame
+ ***************************************************************************//**
+ * \brief  Builds a CMD_DATA_ADDR write frame.
+ * \param  frame  4-byte destination, CRC included.
+ * \param  data   Data written to the addressed register.
+ ******************************************************************************/
+static inline void xensiv_nxf_write_frame(uint8_t frame[4], uint16_t data)
+{
+	frame[0] = XENSIV_NXF_CMD_DATA_ADDR;
+	frame[1] = (uint8_t)((data >> 8) & 0xFF);
+	frame[2] = (uint8_t)(data & 0xFF);
+	frame[3] = xensiv_crc8_j1850(frame, 3, XENSIV_CRC8_J1850_SEED_SPI);
+}
+
+/*******************************************************************************
+ * Function Name: xensiv_nxf_read_list_frame
+ ***************************************************************************//**
+ * \brief  Builds frame i of a register list read, see the file description.
+ * \param  frame        4-byte destination, CRC included.
+ * \param  addrList     Register addresses.
+ * \param  count        Number of registers.
+ * \param  i            Frame index, 0 to count.
+ * \param  clearStatus  If true, the last frame clears the device status.
+ ******************************************************************************/
+static inline void xensiv_nxf_read_list_frame(uint8_t frame[4], const uint16_t *addrList, uint16_t count,
+											  uint16_t i, bool clearStatus)
+{
+	const uint8_t *read;
+
+	if((i == 0) || ((i < count) && (addrList[i] != ((addrList[i - 1] + 1) & XENSIV_NXF_ADDR_MASK))))
+	{
+		xensiv_nxf_command_frame(frame, addrList[i], XENSIV_NXF_AC_READ_INC);
+		return;
+	}
+
+	// Contiguous register or final frame - the pointer auto-increments
+	read = XENSIV_NXF_READ_FRAME[((i == count) && clearStatus) ? 1 : 0];
+
+	frame[0] = read[0];
+	frame[1] = read[1];
+	frame[2] = read[2];
+	frame[3] = read[3];
+}
+
+/*******************************************************************************
+ * Function Name: xensiv_nxf_plan_read_list
+ ***************************************************************************//**
+ * \brief  Builds all frames of a register list read, for queued or DMA
+ *         transfers. The response of frame i + 1 holds register addrList[i].
+ * \param  addrList     Register addresses, any order.
+ * \param  count        Number of registers.
+ * \param  clearStatus  If true, the last frame clears the device status.
+ * \param  frames       Destination, XENSIV_NXF_READ_LIST_FRAMES(count) frames.
+ * \return Number of frames built, 0 if count is 0.
+ ******************************************************************************/
+static inline uint16_t xensiv_nxf_plan_read_list(const uint16_t *addrList, uint16_t count, bool clearStatus,
+												 uint8_t frames[][4])
+{
+	if(count == 0)
+	{
+		return 0;
+	}
+
+	for(uint16_t i = 0; i <= count; i++)
+	{
+		xensiv_nxf_read_list_frame(frames[i], addrList, count, i, clearStatus);
+	}
+
+	return (uint16_t)XENSIV_NXF_READ_LIST_FRAMES(count);
+}
+
+/*******************************************************************************
+ * Function Name: xensiv_nxf_read_list
+ ***************************************************************************//**
+ * \brief  Reads a register list through a blocking transfer function, one
+ *         frame built at a time.
+ * \param  addrList     Register addresses, any order.
+ * \param  count        Number of registers.
+ * \param  clearStatus  If true, the last frame clears the device status.
+ * \param  data         Destination, register data in addrList order. Entries
+ *                      whose response fails the check are left unchanged.
+ * \param  transfer     Sends one frame, returns the checked MISO frame.
+ * \param  context      Passed to transfer.
+ * \return Number of frames sent, count + 1. 0 if count is 0 or if any
+ *         response of the list failed the check.
+ ******************************************************************************/
+static inline uint16_t xensiv_nxf_read_list(const uint16_t *addrList, uint16_t count, bool clearStatus,
+											uint16_t *data, xensiv_nxf_transfer_t transfer, void *context)
+{
+	uint8_t frame[4];
+	xensiv_rsp_frame_t response;
+	bool valid = true;
+
+	if(count == 0)
+	{
+		return 0;
+	}
+
+	for(uint16_t i = 0; i <= count; i++)
+	{
+		xensiv_nxf_read_list_frame(frame, addrList, count, i, clearStatus);
+		response = transfer(frame, context);
+
+		// The first response belongs to whatever was addressed before the list
+		if(i == 0)
+		{
+			continue;
+		}
+
+		// Corrupted frame - keep the old data, fail the list
+		if(response.error != 0)
+		{
+			valid = false;
+			continue;
+		}
+
+		data[i - 1] = response.data;
+	}
+
+	return valid ? (uint16_t)XENSIV_NXF_READ_LIST_FRAMES(count) : 0;
+}
+
+
+#endif /* COMMON_NEXTFRAME_XENSIV_NEXTFRAME_H_ */
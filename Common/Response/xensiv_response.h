@@ -0,0 +1,80 @@
+/**
+ * @file        xensiv_response.h
+ * @brief       Header-only TLx49012 SPI response (MISO frame) decoder.
+ *
+ * Every 32-bit MISO frame holds the device status byte, 16 bits of register data and a CRC8 SAE J1850 over
+ * the first three bytes (seed 0xFF, inverted result, the same as the command frames). A frame is only usable
+ * if its CRC matches: a shifted bit, a floating MISO line or a frame of another slave all fail the check.
+ *
+ * The check costs three lookups in the constant CRC table of xensiv_crc.h, so it is cheap enough to run on
+ * every frame in the SPI completion path. Status bits reported as errors are chosen by the caller, since
+ * their meaning depends on the sensor variant.
+ */
+
+#ifndef COMMON_RESPONSE_XENSIV_RESPONSE_H_
+#define COMMON_RESPONSE_XENSIV_RESPONSE_H_
+
+
+#include <stdint.h>
+#include "xensiv_crc.h"
+
+/*********************************************************************************************************************/
+/*------------------------------------------------------Macros-------------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Error flags of a decoded frame
+#define XENSIV_RSP_ERROR_CRC		0x01	// CRC mismatch - status and data are not usable
+#define XENSIV_RSP_ERROR_STATUS		0x02	// Device status reports an error bit of the caller's mask
+
+/*********************************************************************************************************************/
+/*-------------------------------------------------Data Structures---------------------------------------------------*/
+/*********************************************************************************************************************/
+
+// Decoded 32-bit MISO frame: status, data MSB, data LSB, CRC
+typedef struct
+{
+	uint16_t data;		// Register data
+	uint8_t status;		// Device status byte
+	uint8_t crc;		// CRC byte as received
+	uint8_t error;		// XENSIV_RSP_ERROR_* flags, 0 if the frame can be used
+} xensiv_rsp_frame_t;
+
+/*********************************************************************************************************************/
+/*---------------------------------------------Function Implementations----------------------------------------------*/
+/*********************************************************************************************************************/
+
+/*******************************************************************************
+ * Function Name: xensiv_rsp_decode
+ ***************************************************************************//**
+ * \brief  Splits a MISO frame and checks its CRC and device status.
+ * \param  response         32-bit MISO frame, first byte received in bits 31..24.
+ * \param  statusErrorMask  Device status bits reported as XENSIV_RSP_ERROR_STATUS,
+ *                          0 to only check the CRC.
+ * \return Decoded frame.
+ ******************************************************************************/
+static inline xensiv_rsp_frame_t xensiv_rsp_decode(uint32_t response, uint8_t statusErrorMask)
+{
+	xensiv_rsp_frame_t frame;
+	uint8_t crc;
+
+	frame.status = (uint8_t)(response >> 24);
+	frame.data   = (uint16_t)(response >> 8);
+	frame.crc    = (uint8_t)response;
+
+	// Unrolled table CRC over status, data MSB and data LSB
+	crc = XENSIV_CRC8_J1850_TABLE[XENSIV_CRC8_J1850_SEED_SPI ^ frame.status];
+	crc = XENSIV_CRC8_J1850_TABLE[crc ^ (uint8_t)(response >> 16)];
+	crc = XENSIV_CRC8_J1850_TABLE[crc ^ (uint8_t)(response >> 8)];
+	crc = (uint8_t)~crc;	// Inverted result - kept 8-bit, a promoted ~crc never equals frame.crc
+
+	frame.error = (uint8_t)((crc != frame.crc) ? XENSIV_RSP_ERROR_CRC : 0);
+	if(frame.status & statusErrorMask)
+	{
+		frame.error |= XENSIV_RSP_ERROR_STATUS;
+	}
+
+	return frame;
+}
+
+
+#endif /* COMMON_RESPONSE_XENSIV_RESPONSE_H_ */
@@ -31,6 +31,9 @@
 /*********************************************************************************************************************/
 #include <math.h>
 #include "TLE4998S4_SENT_Redundancy.h"
+/* The CRC tables of the project live here */
+#define XENSIV_CRC_DEFINE_TABLES
+#include "xensiv_crc.h"
 #include "IfxSent_Sent.h"
 #include "IfxSent.h"
 #include "IfxGtm_Tom_Pwm.h"
@@ -281,12 +284,11 @@ void crcCalculation(uint8 channelId)
 uint8 calculateCrcTle4998(uint8 *message, uint8 length)
 {
     uint8 CheckSum = TLE4998_FRAME_CRC_SEED_VAL;
-    char CrcLookup[16] = {0, 13, 7, 10, 14, 3, 9, 4, 1, 12, 6, 11, 15, 2, 8, 5};
     uint8 crcDatalen = TLE4998_FRAME_LENGTH + 1;
     for(uint8 bitdata = 0; bitdata < crcDatalen; bitdata++)
     {
         CheckSum = CheckSum ^ message[bitdata];
-        CheckSum = CrcLookup[CheckSum];
+        CheckSum = XENSIV_CRC4_SENT_TABLE[CheckSum];
     }
     return CheckSum;
 }